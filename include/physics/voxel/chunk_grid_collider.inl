@@ -79,9 +79,12 @@ bool hphys::ChunkGridCollider::determine_candidate_colliding_voxels(
 
     bool any_collidable = false;
 
-    hmem::Handle<hvox::Chunk>           chunk;
-    std::shared_lock<std::shared_mutex> lock;
-    const hvox::Block*                  blocks;
+    hmem::Handle<hvox::Chunk> chunk;
+    hvox::BlockSnapshotHandle snapshot;
+    const hvox::BlockBuffer*  blocks = nullptr;
+    // Set once a uniform chunk's block is found to have no collision shape,
+    // at which point no other block in that chunk need be considered.
+    bool skip_chunk = false;
 
     for (auto x = min_world_block_coord.x; x < max_world_block_coord.x; ++x) {
         for (auto y = min_world_block_coord.y; y < max_world_block_coord.y; ++y) {
@@ -97,18 +100,23 @@ bool hphys::ChunkGridCollider::determine_candidate_colliding_voxels(
                     chunk = chunk_grid->chunk(new_chunk_coord);
                     if (chunk == nullptr) continue;
 
-                    // Chunk exists, get lock on blocks.
-                    blocks = chunk->blocks.get(lock);
+                    // Chunk exists, get snapshot of blocks.
+                    blocks     = &chunk->blocks.get(snapshot);
+                    skip_chunk = false;
 
                     old_chunk_coord = new_chunk_coord;
                 }
 
+                if (skip_chunk) continue;
+
                 auto block_idx
                     = hvox::block_index(hvox::block_chunk_position({ x, y, z }));
-                auto block = blocks[block_idx];
+                auto block = (*blocks)[block_idx];
 
                 btTransform       transform = btTransform::getIdentity();
                 btCollisionShape* shape     = shape_evaluator(block, transform);
+                if (!shape && blocks->is_uniform()) skip_chunk = true;
+
                 if (shape) {
                     // TODO(Matthew): In general, we need to make sure we are getting
                     // the
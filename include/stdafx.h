@@ -39,10 +39,12 @@
 #include <limits>
 #include <memory>
 #include <type_traits>
+#include <typeindex>
 #include <typeinfo>
 #include <utility>
 
 // Thread Handling
+#include <condition_variable>
 #include <mutex>
 #include <shared_mutex>
 #include <thread>
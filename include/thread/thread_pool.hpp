@@ -56,6 +56,14 @@ namespace hemlock {
             virtual void dispose() { /* Empty */
             }
 
+            /**
+             * @brief Whether the task has been cancelled since it
+             * was queued, in which case it is discarded rather than
+             * executed once dequeued. Override this if the task can
+             * be cancelled.
+             */
+            virtual bool is_cancelled() const { return false; }
+
             /**
              * @brief Executes the task, this must be implemented
              * by inheriting tasks.
@@ -183,12 +191,12 @@ namespace hemlock {
             /**
              * @brief The number of threads held by the thread pool.
              */
-            void num_threads() { return m_threads.size(); }
+            size_t num_threads() { return m_threads.size(); }
 
             /**
              * @brief The approximate number of tasks held by the thread pool.
              */
-            void approx_num_tasks() { return m_tasks.size_approx(); }
+            size_t approx_num_tasks() { return m_tasks.size_approx(); }
         protected:
             bool m_is_initialised;
 
@@ -29,7 +29,7 @@ void hthread::basic_thread_main(
             continue;
         }
 
-        held.task->execute(state, task_queue);
+        if (!held.task->is_cancelled()) held.task->execute(state, task_queue);
         held.task->is_finished = true;
         held.task->dispose();
         if (held.should_delete) delete held.task;
@@ -17,6 +17,19 @@ namespace hemlock {
 
                 void generate_buffer();
                 void free_buffer();
+
+                /**
+                 * @brief Empties the navmesh, releasing the memory held by
+                 * its graph while keeping the buffer itself.
+                 */
+                void clear();
+
+                /**
+                 * @brief An estimate of the number of bytes held by this
+                 * manager's navmesh, from the number of nodes and edges in
+                 * its graph.
+                 */
+                size_t allocated_bytes();
             protected:
                 hmem::Handle<ChunkNavmeshPager> m_navmesh_pager;
             };
@@ -1,6 +1,7 @@
 #ifndef __hemlock_voxel_ai_navmesh_navmesh_task_hpp
 #define __hemlock_voxel_ai_navmesh_navmesh_task_hpp
 
+#include "voxel/coordinate_system.h"
 #include "voxel/task.hpp"
 
 namespace hemlock {
@@ -23,6 +24,26 @@ namespace hemlock {
                                                    } -> std::same_as<void>;
                                            };
 
+            /**
+             * @brief Defines a navmesh strategy that can also renavmesh the
+             * bulk of a chunk around just the cuboid given by inclusive start
+             * and end positions, so long as the chunk has been navmeshed
+             * before. Such a do_bulk returns false if it could not do so.
+             */
+            template <typename StrategyCandidate>
+            concept PartialChunkNavmeshStrategy
+                = ChunkNavmeshStrategy<StrategyCandidate>
+                  && requires (
+                      StrategyCandidate       s,
+                      hmem::Handle<ChunkGrid> g,
+                      hmem::Handle<Chunk>     c,
+                      BlockChunkPosition      p
+                  ) {
+                         {
+                             s.do_bulk(g, c, p, p)
+                             } -> std::same_as<bool>;
+                     };
+
             template <hvox::ai::ChunkNavmeshStrategy NavmeshStrategy>
             class ChunkNavmeshTask : public ChunkTask {
             public:
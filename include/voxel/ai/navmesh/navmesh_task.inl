@@ -1,4 +1,5 @@
 #include "voxel/chunk/chunk.h"
+#include "voxel/chunk/grid.h"
 #include "voxel/chunk/state.hpp"
 
 template <hvox::ai::ChunkNavmeshStrategy NavmeshStrategy>
@@ -15,13 +16,37 @@ void hvox::ai::ChunkNavmeshTask<
     chunk->navmeshing.store(ChunkState::ACTIVE, std::memory_order_release);
     chunk->bulk_navmeshing.store(ChunkState::ACTIVE, std::memory_order_release);
 
-    navmesh.do_bulk(chunk_grid, chunk);
+    // Only the bulk around the blocks changed since the chunk was last
+    // navmeshed needs renavmeshing, if we know which they are and the strategy
+    // can make use of that. The whole chunk is marked on generation, so its
+    // first navmesh is always whole.
+    bool               is_partial = false;
+    BlockChunkPosition dirty_start, dirty_end;
+    if (chunk->dirty.navmesh.consume(dirty_start, dirty_end)) {
+        if constexpr (PartialChunkNavmeshStrategy<NavmeshStrategy>) {
+            is_partial = navmesh.do_bulk(chunk_grid, chunk, dirty_start, dirty_end);
+        }
+    }
+
+    // A chunk with no solid block in it has no bulk to navmesh.
+    if (!is_partial
+        && chunk_grid->columns().content(chunk->position) != ChunkContent::EMPTY)
+        navmesh.do_bulk(chunk_grid, chunk);
 
     chunk->bulk_navmeshing.store(ChunkState::COMPLETE, std::memory_order_release);
 
-    navmesh.do_stitch(chunk_grid, chunk);
-
-    chunk->navmeshing.store(ChunkState::COMPLETE, std::memory_order_release);
+    // A partial renavmesh stays clear of the faces of the chunk, and so leaves
+    // stitching with neighbours as it was.
+    if (!is_partial) navmesh.do_stitch(chunk_grid, chunk);
+
+    // If a renavmesh was requested while this one ran, run again to pick up
+    // any blocks changed since it began.
+    ChunkState active_state = ChunkState::ACTIVE;
+    if (!chunk->navmeshing.compare_exchange_strong(
+            active_state, ChunkState::COMPLETE, std::memory_order_acq_rel
+        )
+        && active_state == ChunkState::PENDING)
+        chunk_grid->rerun_chunk_task(chunk, ChunkTaskKind::NAVMESH);
 
     chunk->on_navmesh_change();
 }
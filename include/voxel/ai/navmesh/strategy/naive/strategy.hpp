@@ -14,6 +14,20 @@ namespace hemlock {
                     hmem::Handle<ChunkGrid> chunk_grid, hmem::Handle<Chunk> chunk
                 ) const;
 
+                /**
+                 * @brief Renavmeshes the bulk of the chunk around just the
+                 * cuboid with the given inclusive start and end positions.
+                 *
+                 * @return True if this was done, false if the cuboid is too
+                 * near the faces of the chunk, in which case nothing is done.
+                 */
+                bool do_bulk(
+                    hmem::Handle<ChunkGrid> chunk_grid,
+                    hmem::Handle<Chunk>     chunk,
+                    BlockChunkPosition      dirty_start,
+                    BlockChunkPosition      dirty_end
+                ) const;
+
                 void do_stitch(
                     hmem::Handle<ChunkGrid> chunk_grid, hmem::Handle<Chunk> chunk
                 ) const;
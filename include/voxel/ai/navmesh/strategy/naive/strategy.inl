@@ -2,6 +2,7 @@
 #include "voxel/ai/navmesh/state.hpp"
 #include "voxel/chunk/chunk.h"
 #include "voxel/coordinate_system.h"
+#include "voxel/face_check.hpp"
 
 // TODO(Matthew): right now we are hardcoding in what gets added to the navmesh. This is
 //                fine for now, but perhaps we would like to avoid requiring all the
@@ -58,38 +59,27 @@ namespace hemlock::voxel::ai::impl {
             return vertex;
         }
     }
-}  // namespace hemlock::voxel::ai::impl
-
-template <hvox::IdealBlockConstraint IsSolid>
-void hvox::ai::NaiveNavmeshStrategy<IsSolid>::do_bulk(
-    hmem::Handle<ChunkGrid>, hmem::Handle<Chunk> chunk
-) const {
-    auto chunk_pos = chunk->position;
-
-    std::shared_lock<std::shared_mutex> block_lock;
-    const Block*                        blocks = chunk->blocks.get(block_lock);
-
-    const IsSolid is_solid{};
-
-    //----------------------------------------------------------------------------------
-    //
-    // Navmesh within this chunk.
-    //----------------------------------------------------------------------------------
-
-    // We don't navmesh up to the very top face of the chunk, as this is handled in
-    // stitching phase. To step onto "top face" is to step into the above-neighbouring
-    // chunk.
-
-    /*****************************\
-     * In-chunk navigable check. *
-    \*****************************/
 
     // TODO(Matthew): Is this optimised well by compiler?
-    auto do_navigable_check = [&](const ChunkNavmeshVertexDescriptor& block_vertex,
-                                  BlockChunkPosition                  start_offset,
-                                  BlockChunkPosition                  offset,
-                                  i64                                 start,
-                                  i64                                 end) {
+    /**
+     * @brief Links the given block with each block of the column at offset that
+     * may be stepped to from it, checking from start blocks above offset down
+     * to, but excluding, end blocks above it.
+     */
+    template <hvox::IdealBlockConstraint IsSolid>
+    void do_navigable_check(
+        hmem::Handle<Chunk>&                chunk,
+        const BlockBuffer&                  blocks,
+        const ChunkNavmeshVertexDescriptor& block_vertex,
+        BlockChunkPosition                  start_offset,
+        BlockChunkPosition                  offset,
+        i64                                 start,
+        i64                                 end
+    ) {
+        auto chunk_pos = chunk->position;
+
+        const IsSolid is_solid{};
+
         for (i64 y_off = start; y_off > end; --y_off) {
             BlockIndex above_candidate_index
                 = hvox::block_index(static_cast<i64v3>(offset) + i64v3{ 0, y_off, 0 });
@@ -147,6 +137,46 @@ void hvox::ai::NaiveNavmeshStrategy<IsSolid>::do_bulk(
                 }
             }
         }
+    }
+}  // namespace hemlock::voxel::ai::impl
+
+template <hvox::IdealBlockConstraint IsSolid>
+void hvox::ai::NaiveNavmeshStrategy<IsSolid>::do_bulk(
+    hmem::Handle<ChunkGrid>, hmem::Handle<Chunk> chunk
+) const {
+    auto chunk_pos = chunk->position;
+
+    BlockSnapshotHandle block_snapshot;
+    const BlockBuffer&  blocks = chunk->blocks.get(block_snapshot);
+
+    // A uniform chunk has no navigable blocks within its bulk: either no block
+    // is solid, or every solid block but those of the top face is covered,
+    // and the top face is handled in the stitching phase.
+    if (blocks.is_uniform()) return;
+
+    const IsSolid is_solid{};
+
+    //----------------------------------------------------------------------------------
+    //
+    // Navmesh within this chunk.
+    //----------------------------------------------------------------------------------
+
+    // We don't navmesh up to the very top face of the chunk, as this is handled in
+    // stitching phase. To step onto "top face" is to step into the above-neighbouring
+    // chunk.
+
+    /*****************************\
+     * In-chunk navigable check. *
+    \*****************************/
+
+    auto do_navigable_check = [&](const ChunkNavmeshVertexDescriptor& block_vertex,
+                                  BlockChunkPosition                  start_offset,
+                                  BlockChunkPosition                  offset,
+                                  i64                                 start,
+                                  i64                                 end) {
+        impl::do_navigable_check<IsSolid>(
+            chunk, blocks, block_vertex, start_offset, offset, start, end
+        );
     };
 
     /*******************************\
@@ -1331,14 +1361,111 @@ void hvox::ai::NaiveNavmeshStrategy<IsSolid>::do_bulk(
 ////////////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////
 
+template <hvox::IdealBlockConstraint IsSolid>
+bool hvox::ai::NaiveNavmeshStrategy<IsSolid>::do_bulk(
+    hmem::Handle<ChunkGrid>,
+    hmem::Handle<Chunk> chunk,
+    BlockChunkPosition  dirty_start,
+    BlockChunkPosition  dirty_end
+) const {
+    auto chunk_pos = chunk->position;
+
+    BlockSnapshotHandle block_snapshot;
+    const BlockBuffer&  blocks = chunk->blocks.get(block_snapshot);
+
+    // Leave uniform chunks to the full pass, which knows they have no bulk.
+    if (blocks.is_uniform()) return false;
+
+    const IsSolid is_solid{};
+
+    // Whether a block links to another depends on the blocks up to two above
+    // each of them, so changes may alter links of blocks up to two below the
+    // dirty region. We also take in the blocks to either side, as those are
+    // the blocks that can be linked to.
+    if (dirty_start.x < 2 || dirty_start.y < 3 || dirty_start.z < 2) return false;
+    if (dirty_end.x > CHUNK_LENGTH - 3 || dirty_end.y > CHUNK_LENGTH - 3
+        || dirty_end.z > CHUNK_LENGTH - 3)
+        return false;
+
+    // With the above, the region lies wholly within the bulk of the chunk,
+    // so that no block in it has links formed by stitching.
+    const BlockChunkPosition start = dirty_start - BlockChunkPosition{ 1, 2, 1 };
+    const BlockChunkPosition end   = dirty_end + BlockChunkPosition{ 1, 1, 1 };
+
+    /***************************\
+     * Unlink blocks in region. *
+    \***************************/
+
+    {
+        std::unique_lock<std::shared_mutex> lock;
+        auto&                               navmesh = chunk->navmesh.get(lock);
+
+        for_each_block_in(start, end, [&](BlockIndex, BlockChunkPosition position) {
+            auto it = navmesh->coord_vertex_map.find({ position, chunk_pos });
+            if (it == navmesh->coord_vertex_map.end()) return;
+
+            // Links are always made both ways, so the blocks linking to this
+            // block are exactly those it links to.
+            auto [edge, last_edge] = boost::out_edges(it->second, navmesh->graph);
+            for (; edge != last_edge; ++edge) {
+                boost::remove_edge(
+                    boost::target(*edge, navmesh->graph), it->second, navmesh->graph
+                );
+            }
+            boost::clear_out_edges(it->second, navmesh->graph);
+        });
+    }
+
+    /***************************\
+     * Relink blocks in region. *
+    \***************************/
+
+    for_each_block_in(start, end, [&](BlockIndex index, BlockChunkPosition position) {
+        // Only consider block if it is solid and not covered above.
+        if (!is_solid(&blocks[index])) return;
+        if (is_solid(&blocks[index_above(index)])) return;
+
+        // Ensure node exists for this block.
+        ChunkNavmeshVertexDescriptor block_vertex
+            = impl::get_vertex(chunk, ChunkNavmeshNode{ position, chunk_pos });
+
+        // Blocks on the second-to-top layer can't step up within the chunk.
+        i64 step_start = position.y == CHUNK_LENGTH - 2 ? 1 : 2;
+
+        BlockChunkPositionCoord x = position.x, y = position.y, z = position.z;
+
+        // Left
+        impl::do_navigable_check<IsSolid>(
+            chunk, blocks, block_vertex, position, { x - 1, y, z }, step_start, -1
+        );
+
+        // Right
+        impl::do_navigable_check<IsSolid>(
+            chunk, blocks, block_vertex, position, { x + 1, y, z }, step_start, -1
+        );
+
+        // Front
+        impl::do_navigable_check<IsSolid>(
+            chunk, blocks, block_vertex, position, { x, y, z + 1 }, step_start, -1
+        );
+
+        // Back
+        impl::do_navigable_check<IsSolid>(
+            chunk, blocks, block_vertex, position, { x, y, z - 1 }, step_start, -1
+        );
+    });
+
+    return true;
+}
+
 template <hvox::IdealBlockConstraint IsSolid>
 void hvox::ai::NaiveNavmeshStrategy<IsSolid>::do_stitch(
     hmem::Handle<ChunkGrid>, hmem::Handle<Chunk> chunk
 ) const {
     auto chunk_pos = chunk->position;
 
-    std::shared_lock<std::shared_mutex> block_lock;
-    const Block*                        blocks = chunk->blocks.get(block_lock);
+    BlockSnapshotHandle block_snapshot;
+    const BlockBuffer&  blocks = chunk->blocks.get(block_snapshot);
 
     const IsSolid is_solid{};
 
@@ -1359,8 +1486,9 @@ void hvox::ai::NaiveNavmeshStrategy<IsSolid>::do_stitch(
                                               BlockChunkPosition     neighbour_offset,
                                               i64                    start,
                                               i64                    end) {
-        std::shared_lock<std::shared_mutex> neighbour_block_lock;
-        auto& neighbour_blocks = neighbour->blocks.get(neighbour_block_lock);
+        BlockSnapshotHandle neighbour_block_snapshot;
+        auto&               neighbour_blocks
+            = neighbour->blocks.get(neighbour_block_snapshot);
 
         BlockIndex   this_block_index = hvox::block_index(this_offset);
         const Block* this_block       = &blocks[this_block_index];
@@ -1441,7 +1569,7 @@ void hvox::ai::NaiveNavmeshStrategy<IsSolid>::do_stitch(
     \*********************************/
 
     {
-        auto       neighbour    = chunk->neighbours.one.left.lock();
+        auto       neighbour    = chunk->neighbour(ChunkFace::LEFT);
         ChunkState stitch_state = ChunkState::NONE;
         if (neighbour != nullptr
             && neighbour->bulk_navmeshing.load() == ChunkState::COMPLETE
@@ -1449,8 +1577,9 @@ void hvox::ai::NaiveNavmeshStrategy<IsSolid>::do_stitch(
                 stitch_state, ChunkState::ACTIVE
             ))
         {
-            std::shared_lock<std::shared_mutex> neighbour_block_lock;
-            auto& neighbour_blocks = neighbour->blocks.get(neighbour_block_lock);
+            BlockSnapshotHandle neighbour_block_snapshot;
+            auto&               neighbour_blocks
+                = neighbour->blocks.get(neighbour_block_snapshot);
 
             for (BlockChunkPositionCoord z = 0; z < CHUNK_LENGTH; ++z) {
                 for (BlockChunkPositionCoord y = 1; y < CHUNK_LENGTH - 2; ++y) {
@@ -1482,7 +1611,7 @@ void hvox::ai::NaiveNavmeshStrategy<IsSolid>::do_stitch(
             }
 
             // y == 0 - step down
-            auto       below_neighbour    = neighbour->neighbours.one.bottom.lock();
+            auto       below_neighbour    = neighbour->neighbour(ChunkFace::BOTTOM);
             ChunkState below_stitch_state = ChunkState::NONE;
             if (below_neighbour != nullptr
                 && below_neighbour->bulk_navmeshing.load() == ChunkState::COMPLETE
@@ -1490,9 +1619,9 @@ void hvox::ai::NaiveNavmeshStrategy<IsSolid>::do_stitch(
                     below_stitch_state, ChunkState::ACTIVE
                 ))
             {
-                std::shared_lock<std::shared_mutex> below_neighbour_block_lock;
-                auto                                below_neighbour_blocks
-                    = below_neighbour->blocks.get(below_neighbour_block_lock);
+                BlockSnapshotHandle below_neighbour_block_snapshot;
+                auto&               below_neighbour_blocks
+                    = below_neighbour->blocks.get(below_neighbour_block_snapshot);
 
                 for (BlockChunkPositionCoord z = 0; z < CHUNK_LENGTH; ++z) {
                     BlockIndex   this_block_index = hvox::block_index({ 0, 0, z });
@@ -1591,7 +1720,7 @@ void hvox::ai::NaiveNavmeshStrategy<IsSolid>::do_stitch(
     \**********************************/
 
     {
-        auto       neighbour    = chunk->neighbours.one.right.lock();
+        auto       neighbour    = chunk->neighbour(ChunkFace::RIGHT);
         ChunkState stitch_state = ChunkState::NONE;
         if (neighbour != nullptr
             && neighbour->bulk_navmeshing.load() == ChunkState::COMPLETE
@@ -1599,8 +1728,9 @@ void hvox::ai::NaiveNavmeshStrategy<IsSolid>::do_stitch(
                 stitch_state, ChunkState::ACTIVE
             ))
         {
-            std::shared_lock<std::shared_mutex> neighbour_block_lock;
-            auto& neighbour_blocks = neighbour->blocks.get(neighbour_block_lock);
+            BlockSnapshotHandle neighbour_block_snapshot;
+            auto&               neighbour_blocks
+                = neighbour->blocks.get(neighbour_block_snapshot);
             for (BlockChunkPositionCoord z = 0; z < CHUNK_LENGTH; ++z) {
                 for (BlockChunkPositionCoord y = 1; y < CHUNK_LENGTH - 2; ++y) {
                     do_side_stitch_navigable_check(
@@ -1631,7 +1761,7 @@ void hvox::ai::NaiveNavmeshStrategy<IsSolid>::do_stitch(
             }
 
             // y == 0 - step down
-            auto       below_neighbour    = neighbour->neighbours.one.bottom.lock();
+            auto       below_neighbour    = neighbour->neighbour(ChunkFace::BOTTOM);
             ChunkState below_stitch_state = ChunkState::NONE;
             if (below_neighbour != nullptr
                 && below_neighbour->bulk_navmeshing.load() == ChunkState::COMPLETE
@@ -1639,9 +1769,9 @@ void hvox::ai::NaiveNavmeshStrategy<IsSolid>::do_stitch(
                     below_stitch_state, ChunkState::ACTIVE
                 ))
             {
-                std::shared_lock<std::shared_mutex> below_neighbour_block_lock;
-                auto                                below_neighbour_blocks
-                    = below_neighbour->blocks.get(below_neighbour_block_lock);
+                BlockSnapshotHandle below_neighbour_block_snapshot;
+                auto&               below_neighbour_blocks
+                    = below_neighbour->blocks.get(below_neighbour_block_snapshot);
 
                 for (BlockChunkPositionCoord z = 0; z < CHUNK_LENGTH; ++z) {
                     BlockIndex this_block_index
@@ -1740,7 +1870,7 @@ void hvox::ai::NaiveNavmeshStrategy<IsSolid>::do_stitch(
     \**********************************/
 
     {
-        auto       neighbour    = chunk->neighbours.one.front.lock();
+        auto       neighbour    = chunk->neighbour(ChunkFace::FRONT);
         ChunkState stitch_state = ChunkState::NONE;
         if (neighbour != nullptr
             && neighbour->bulk_navmeshing.load() == ChunkState::COMPLETE
@@ -1748,8 +1878,9 @@ void hvox::ai::NaiveNavmeshStrategy<IsSolid>::do_stitch(
                 stitch_state, ChunkState::ACTIVE
             ))
         {
-            std::shared_lock<std::shared_mutex> neighbour_block_lock;
-            auto& neighbour_blocks = neighbour->blocks.get(neighbour_block_lock);
+            BlockSnapshotHandle neighbour_block_snapshot;
+            auto&               neighbour_blocks
+                = neighbour->blocks.get(neighbour_block_snapshot);
             for (BlockChunkPositionCoord x = 0; x < CHUNK_LENGTH; ++x) {
                 for (BlockChunkPositionCoord y = 1; y < CHUNK_LENGTH - 2; ++y) {
                     do_side_stitch_navigable_check(
@@ -1780,7 +1911,7 @@ void hvox::ai::NaiveNavmeshStrategy<IsSolid>::do_stitch(
             }
 
             // y == 0 - step down
-            auto       below_neighbour    = neighbour->neighbours.one.bottom.lock();
+            auto       below_neighbour    = neighbour->neighbour(ChunkFace::BOTTOM);
             ChunkState below_stitch_state = ChunkState::NONE;
             if (below_neighbour != nullptr
                 && below_neighbour->bulk_navmeshing.load() == ChunkState::COMPLETE
@@ -1788,9 +1919,9 @@ void hvox::ai::NaiveNavmeshStrategy<IsSolid>::do_stitch(
                     below_stitch_state, ChunkState::ACTIVE
                 ))
             {
-                std::shared_lock<std::shared_mutex> below_neighbour_block_lock;
-                auto                                below_neighbour_blocks
-                    = below_neighbour->blocks.get(below_neighbour_block_lock);
+                BlockSnapshotHandle below_neighbour_block_snapshot;
+                auto&               below_neighbour_blocks
+                    = below_neighbour->blocks.get(below_neighbour_block_snapshot);
 
                 for (BlockChunkPositionCoord x = 0; x < CHUNK_LENGTH; ++x) {
                     BlockIndex this_block_index
@@ -1890,7 +2021,7 @@ void hvox::ai::NaiveNavmeshStrategy<IsSolid>::do_stitch(
     \*********************************/
 
     {
-        auto       neighbour    = chunk->neighbours.one.back.lock();
+        auto       neighbour    = chunk->neighbour(ChunkFace::BACK);
         ChunkState stitch_state = ChunkState::NONE;
         if (neighbour != nullptr
             && neighbour->bulk_navmeshing.load() == ChunkState::COMPLETE
@@ -1898,8 +2029,9 @@ void hvox::ai::NaiveNavmeshStrategy<IsSolid>::do_stitch(
                 stitch_state, ChunkState::ACTIVE
             ))
         {
-            std::shared_lock<std::shared_mutex> neighbour_block_lock;
-            auto& neighbour_blocks = neighbour->blocks.get(neighbour_block_lock);
+            BlockSnapshotHandle neighbour_block_snapshot;
+            auto&               neighbour_blocks
+                = neighbour->blocks.get(neighbour_block_snapshot);
             for (BlockChunkPositionCoord x = 0; x < CHUNK_LENGTH; ++x) {
                 for (BlockChunkPositionCoord y = 1; y < CHUNK_LENGTH - 2; ++y) {
                     do_side_stitch_navigable_check(
@@ -1930,7 +2062,7 @@ void hvox::ai::NaiveNavmeshStrategy<IsSolid>::do_stitch(
             }
 
             // y == 0 - step down
-            auto       below_neighbour    = neighbour->neighbours.one.bottom.lock();
+            auto       below_neighbour    = neighbour->neighbour(ChunkFace::BOTTOM);
             ChunkState below_stitch_state = ChunkState::NONE;
             if (below_neighbour != nullptr
                 && below_neighbour->bulk_navmeshing.load() == ChunkState::COMPLETE
@@ -1938,9 +2070,9 @@ void hvox::ai::NaiveNavmeshStrategy<IsSolid>::do_stitch(
                     below_stitch_state, ChunkState::ACTIVE
                 ))
             {
-                std::shared_lock<std::shared_mutex> below_neighbour_block_lock;
-                auto                                below_neighbour_blocks
-                    = below_neighbour->blocks.get(below_neighbour_block_lock);
+                BlockSnapshotHandle below_neighbour_block_snapshot;
+                auto&               below_neighbour_blocks
+                    = below_neighbour->blocks.get(below_neighbour_block_snapshot);
 
                 for (BlockChunkPositionCoord x = 0; x < CHUNK_LENGTH; ++x) {
                     BlockIndex   this_block_index = hvox::block_index({ x, 0, 0 });
@@ -2038,7 +2170,7 @@ void hvox::ai::NaiveNavmeshStrategy<IsSolid>::do_stitch(
     \********************************/
 
     {
-        auto       neighbour    = chunk->neighbours.one.top.lock();
+        auto       neighbour    = chunk->neighbour(ChunkFace::TOP);
         ChunkState stitch_state = ChunkState::NONE;
         if (neighbour != nullptr
             && neighbour->bulk_navmeshing.load() == ChunkState::COMPLETE
@@ -2046,8 +2178,9 @@ void hvox::ai::NaiveNavmeshStrategy<IsSolid>::do_stitch(
                 stitch_state, ChunkState::ACTIVE
             ))
         {
-            std::shared_lock<std::shared_mutex> neighbour_block_lock;
-            auto& neighbour_blocks = neighbour->blocks.get(neighbour_block_lock);
+            BlockSnapshotHandle neighbour_block_snapshot;
+            auto&               neighbour_blocks
+                = neighbour->blocks.get(neighbour_block_snapshot);
             for (BlockChunkPositionCoord x = 1; x < CHUNK_LENGTH - 1; ++x) {
                 for (BlockChunkPositionCoord z = 1; z < CHUNK_LENGTH - 1; ++z) {
                     BlockIndex this_block_index
@@ -2643,7 +2776,7 @@ void hvox::ai::NaiveNavmeshStrategy<IsSolid>::do_stitch(
 
             // Left
             {
-                auto       left_of_neighbour = neighbour->neighbours.one.left.lock();
+                auto       left_of_neighbour = chunk->neighbour(-1, 1, 0);
                 ChunkState left_of_neighbour_stitch_state = ChunkState::NONE;
                 if (left_of_neighbour != nullptr
                     && left_of_neighbour->bulk_navmeshing.load() == ChunkState::COMPLETE
@@ -2651,9 +2784,11 @@ void hvox::ai::NaiveNavmeshStrategy<IsSolid>::do_stitch(
                         left_of_neighbour_stitch_state, ChunkState::ACTIVE
                     ))
                 {
-                    std::shared_lock<std::shared_mutex> left_of_neighbour_block_lock;
-                    auto                                left_of_neighbour_blocks
-                        = left_of_neighbour->blocks.get(left_of_neighbour_block_lock);
+                    BlockSnapshotHandle left_of_neighbour_block_snapshot;
+                    auto&               left_of_neighbour_blocks
+                        = left_of_neighbour->blocks.get(
+                            left_of_neighbour_block_snapshot
+                        );
 
                     for (BlockChunkPositionCoord z = 0; z < CHUNK_LENGTH; ++z) {
                         BlockIndex left_of_neighbour_block_index
@@ -2755,7 +2890,7 @@ void hvox::ai::NaiveNavmeshStrategy<IsSolid>::do_stitch(
 
             // Right
             {
-                auto       right_of_neighbour = neighbour->neighbours.one.right.lock();
+                auto       right_of_neighbour = chunk->neighbour(1, 1, 0);
                 ChunkState right_of_neighbour_stitch_state = ChunkState::NONE;
                 if (right_of_neighbour != nullptr
                     && right_of_neighbour->bulk_navmeshing.load()
@@ -2764,9 +2899,11 @@ void hvox::ai::NaiveNavmeshStrategy<IsSolid>::do_stitch(
                         right_of_neighbour_stitch_state, ChunkState::ACTIVE
                     ))
                 {
-                    std::shared_lock<std::shared_mutex> right_of_neighbour_block_lock;
-                    auto                                right_of_neighbour_blocks
-                        = right_of_neighbour->blocks.get(right_of_neighbour_block_lock);
+                    BlockSnapshotHandle right_of_neighbour_block_snapshot;
+                    auto&               right_of_neighbour_blocks
+                        = right_of_neighbour->blocks.get(
+                            right_of_neighbour_block_snapshot
+                        );
 
                     for (BlockChunkPositionCoord z = 0; z < CHUNK_LENGTH; ++z) {
                         BlockIndex right_of_neighbour_block_index
@@ -2873,7 +3010,7 @@ void hvox::ai::NaiveNavmeshStrategy<IsSolid>::do_stitch(
 
             // Front
             {
-                auto       front_of_neighbour = neighbour->neighbours.one.front.lock();
+                auto       front_of_neighbour = chunk->neighbour(0, 1, 1);
                 ChunkState front_of_neighbour_stitch_state = ChunkState::NONE;
                 if (front_of_neighbour != nullptr
                     && front_of_neighbour->bulk_navmeshing.load()
@@ -2882,9 +3019,11 @@ void hvox::ai::NaiveNavmeshStrategy<IsSolid>::do_stitch(
                         front_of_neighbour_stitch_state, ChunkState::ACTIVE
                     ))
                 {
-                    std::shared_lock<std::shared_mutex> front_of_neighbour_block_lock;
-                    auto                                front_of_neighbour_blocks
-                        = front_of_neighbour->blocks.get(front_of_neighbour_block_lock);
+                    BlockSnapshotHandle front_of_neighbour_block_snapshot;
+                    auto&               front_of_neighbour_blocks
+                        = front_of_neighbour->blocks.get(
+                            front_of_neighbour_block_snapshot
+                        );
 
                     for (BlockChunkPositionCoord x = 0; x < CHUNK_LENGTH; ++x) {
                         BlockIndex front_of_neighbour_block_index
@@ -2991,7 +3130,7 @@ void hvox::ai::NaiveNavmeshStrategy<IsSolid>::do_stitch(
 
             // Back
             {
-                auto       back_of_neighbour = neighbour->neighbours.one.back.lock();
+                auto       back_of_neighbour = chunk->neighbour(0, 1, -1);
                 ChunkState back_of_neighbour_stitch_state = ChunkState::NONE;
                 if (back_of_neighbour != nullptr
                     && back_of_neighbour->bulk_navmeshing.load() == ChunkState::COMPLETE
@@ -2999,9 +3138,11 @@ void hvox::ai::NaiveNavmeshStrategy<IsSolid>::do_stitch(
                         back_of_neighbour_stitch_state, ChunkState::ACTIVE
                     ))
                 {
-                    std::shared_lock<std::shared_mutex> back_of_neighbour_block_lock;
-                    auto                                back_of_neighbour_blocks
-                        = back_of_neighbour->blocks.get(back_of_neighbour_block_lock);
+                    BlockSnapshotHandle back_of_neighbour_block_snapshot;
+                    auto&               back_of_neighbour_blocks
+                        = back_of_neighbour->blocks.get(
+                            back_of_neighbour_block_snapshot
+                        );
 
                     for (BlockChunkPositionCoord x = 0; x < CHUNK_LENGTH; ++x) {
                         BlockIndex back_of_neighbour_block_index
@@ -3107,8 +3248,8 @@ void hvox::ai::NaiveNavmeshStrategy<IsSolid>::do_stitch(
 
             // Left
             {
-                auto       left_neighbour       = chunk->neighbours.one.left.lock();
-                auto       above_left_neighbour = neighbour->neighbours.one.left.lock();
+                auto       left_neighbour       = chunk->neighbour(ChunkFace::LEFT);
+                auto       above_left_neighbour = chunk->neighbour(-1, 1, 0);
                 ChunkState diagonal_stitch_state = ChunkState::NONE;
                 if (left_neighbour != nullptr && above_left_neighbour != nullptr
                     && left_neighbour->bulk_navmeshing.load() == ChunkState::COMPLETE
@@ -3119,13 +3260,13 @@ void hvox::ai::NaiveNavmeshStrategy<IsSolid>::do_stitch(
                                diagonal_stitch_state, ChunkState::ACTIVE
                            ))
                 {
-                    std::shared_lock<std::shared_mutex> left_neighbour_block_lock,
-                        above_left_neighbour_block_lock;
+                    BlockSnapshotHandle left_neighbour_block_snapshot,
+                        above_left_neighbour_block_snapshot;
                     auto& left_neighbour_blocks
-                        = left_neighbour->blocks.get(left_neighbour_block_lock);
+                        = left_neighbour->blocks.get(left_neighbour_block_snapshot);
                     auto& above_left_neighbour_blocks
                         = above_left_neighbour->blocks.get(
-                            above_left_neighbour_block_lock
+                            above_left_neighbour_block_snapshot
                         );
 
                     // Step up from y == CHUNK_LENGTH - 2
@@ -3366,8 +3507,8 @@ void hvox::ai::NaiveNavmeshStrategy<IsSolid>::do_stitch(
 
             // Right
             {
-                auto right_neighbour       = chunk->neighbours.one.right.lock();
-                auto above_right_neighbour = neighbour->neighbours.one.right.lock();
+                auto right_neighbour       = chunk->neighbour(ChunkFace::RIGHT);
+                auto above_right_neighbour = chunk->neighbour(1, 1, 0);
                 ChunkState diagonal_stitch_state = ChunkState::NONE;
                 if (right_neighbour != nullptr && above_right_neighbour != nullptr
                     && right_neighbour->bulk_navmeshing.load() == ChunkState::COMPLETE
@@ -3378,14 +3519,13 @@ void hvox::ai::NaiveNavmeshStrategy<IsSolid>::do_stitch(
                                diagonal_stitch_state, ChunkState::ACTIVE
                            ))
                 {
-                    std::shared_lock<std::shared_mutex> right_neighbour_block_lock;
-                    auto                                right_neighbour_blocks
-                        = right_neighbour->blocks.get(right_neighbour_block_lock);
-                    std::shared_lock<std::shared_mutex>
-                         above_right_neighbour_block_lock;
-                    auto above_right_neighbour_blocks
+                    BlockSnapshotHandle right_neighbour_block_snapshot;
+                    auto&               right_neighbour_blocks
+                        = right_neighbour->blocks.get(right_neighbour_block_snapshot);
+                    BlockSnapshotHandle above_right_neighbour_block_snapshot;
+                    auto&               above_right_neighbour_blocks
                         = above_right_neighbour->blocks.get(
-                            above_right_neighbour_block_lock
+                            above_right_neighbour_block_snapshot
                         );
 
                     // Step up from y == CHUNK_LENGTH - 2
@@ -3626,8 +3766,8 @@ void hvox::ai::NaiveNavmeshStrategy<IsSolid>::do_stitch(
 
             // Front
             {
-                auto front_neighbour       = chunk->neighbours.one.front.lock();
-                auto above_front_neighbour = neighbour->neighbours.one.front.lock();
+                auto front_neighbour       = chunk->neighbour(ChunkFace::FRONT);
+                auto above_front_neighbour = chunk->neighbour(0, 1, 1);
                 ChunkState diagonal_stitch_state = ChunkState::NONE;
                 if (front_neighbour != nullptr && above_front_neighbour != nullptr
                     && front_neighbour->bulk_navmeshing.load() == ChunkState::COMPLETE
@@ -3638,14 +3778,13 @@ void hvox::ai::NaiveNavmeshStrategy<IsSolid>::do_stitch(
                                diagonal_stitch_state, ChunkState::ACTIVE
                            ))
                 {
-                    std::shared_lock<std::shared_mutex> front_neighbour_block_lock;
-                    auto                                front_neighbour_blocks
-                        = front_neighbour->blocks.get(front_neighbour_block_lock);
-                    std::shared_lock<std::shared_mutex>
-                         above_front_neighbour_block_lock;
-                    auto above_front_neighbour_blocks
+                    BlockSnapshotHandle front_neighbour_block_snapshot;
+                    auto&               front_neighbour_blocks
+                        = front_neighbour->blocks.get(front_neighbour_block_snapshot);
+                    BlockSnapshotHandle above_front_neighbour_block_snapshot;
+                    auto&               above_front_neighbour_blocks
                         = above_front_neighbour->blocks.get(
-                            above_front_neighbour_block_lock
+                            above_front_neighbour_block_snapshot
                         );
 
                     // Step up from y == CHUNK_LENGTH - 2
@@ -3886,8 +4025,8 @@ void hvox::ai::NaiveNavmeshStrategy<IsSolid>::do_stitch(
 
             // Back
             {
-                auto       back_neighbour       = chunk->neighbours.one.back.lock();
-                auto       above_back_neighbour = neighbour->neighbours.one.back.lock();
+                auto       back_neighbour       = chunk->neighbour(ChunkFace::BACK);
+                auto       above_back_neighbour = chunk->neighbour(0, 1, -1);
                 ChunkState diagonal_stitch_state = ChunkState::NONE;
                 if (back_neighbour != nullptr && above_back_neighbour != nullptr
                     && back_neighbour->bulk_navmeshing.load() == ChunkState::COMPLETE
@@ -3898,13 +4037,13 @@ void hvox::ai::NaiveNavmeshStrategy<IsSolid>::do_stitch(
                                diagonal_stitch_state, ChunkState::ACTIVE
                            ))
                 {
-                    std::shared_lock<std::shared_mutex> back_neighbour_block_lock,
-                        above_back_neighbour_block_lock;
+                    BlockSnapshotHandle back_neighbour_block_snapshot,
+                        above_back_neighbour_block_snapshot;
                     auto& back_neighbour_blocks
-                        = back_neighbour->blocks.get(back_neighbour_block_lock);
+                        = back_neighbour->blocks.get(back_neighbour_block_snapshot);
                     auto& above_back_neighbour_blocks
                         = above_back_neighbour->blocks.get(
-                            above_back_neighbour_block_lock
+                            above_back_neighbour_block_snapshot
                         );
 
                     // Step up from y == CHUNK_LENGTH - 2
@@ -4152,7 +4291,7 @@ void hvox::ai::NaiveNavmeshStrategy<IsSolid>::do_stitch(
     \***********************************/
 
     {
-        auto       neighbour    = chunk->neighbours.one.bottom.lock();
+        auto       neighbour    = chunk->neighbour(ChunkFace::BOTTOM);
         ChunkState stitch_state = ChunkState::NONE;
         if (neighbour != nullptr
             && neighbour->bulk_navmeshing.load() == ChunkState::COMPLETE
@@ -4160,8 +4299,9 @@ void hvox::ai::NaiveNavmeshStrategy<IsSolid>::do_stitch(
                 stitch_state, ChunkState::ACTIVE
             ))
         {
-            std::shared_lock<std::shared_mutex> neighbour_block_lock;
-            auto& neighbour_blocks = neighbour->blocks.get(neighbour_block_lock);
+            BlockSnapshotHandle neighbour_block_snapshot;
+            auto&               neighbour_blocks
+                = neighbour->blocks.get(neighbour_block_snapshot);
             for (BlockChunkPositionCoord x = 1; x < CHUNK_LENGTH - 1; ++x) {
                 for (BlockChunkPositionCoord z = 1; z < CHUNK_LENGTH - 1; ++z) {
                     BlockIndex   this_block_index = hvox::block_index({ x, 0, z });
@@ -4752,8 +4892,8 @@ void hvox::ai::NaiveNavmeshStrategy<IsSolid>::do_stitch(
 
             // Left
             {
-                auto       left_neighbour       = chunk->neighbours.one.left.lock();
-                auto       below_left_neighbour = neighbour->neighbours.one.left.lock();
+                auto       left_neighbour       = chunk->neighbour(ChunkFace::LEFT);
+                auto       below_left_neighbour = chunk->neighbour(-1, -1, 0);
                 ChunkState neighbour_stitch_state = ChunkState::NONE;
                 if (left_neighbour != nullptr && below_left_neighbour != nullptr
                     && left_neighbour->bulk_navmeshing.load() == ChunkState::COMPLETE
@@ -4764,13 +4904,13 @@ void hvox::ai::NaiveNavmeshStrategy<IsSolid>::do_stitch(
                                neighbour_stitch_state, ChunkState::ACTIVE
                            ))
                 {
-                    std::shared_lock<std::shared_mutex> left_neighbour_block_lock,
-                        below_left_neighbour_block_lock;
+                    BlockSnapshotHandle left_neighbour_block_snapshot,
+                        below_left_neighbour_block_snapshot;
                     auto& left_neighbour_blocks
-                        = left_neighbour->blocks.get(left_neighbour_block_lock);
+                        = left_neighbour->blocks.get(left_neighbour_block_snapshot);
                     auto& below_left_neighbour_blocks
                         = below_left_neighbour->blocks.get(
-                            below_left_neighbour_block_lock
+                            below_left_neighbour_block_snapshot
                         );
 
                     // Step up from y == CHUNK_LENGTH - 2
@@ -5028,8 +5168,8 @@ void hvox::ai::NaiveNavmeshStrategy<IsSolid>::do_stitch(
 
             // Right
             {
-                auto right_neighbour       = chunk->neighbours.one.right.lock();
-                auto below_right_neighbour = neighbour->neighbours.one.right.lock();
+                auto right_neighbour       = chunk->neighbour(ChunkFace::RIGHT);
+                auto below_right_neighbour = chunk->neighbour(1, -1, 0);
                 ChunkState neighbour_stitch_state = ChunkState::NONE;
                 if (right_neighbour != nullptr && below_right_neighbour != nullptr
                     && right_neighbour->bulk_navmeshing.load() == ChunkState::COMPLETE
@@ -5040,14 +5180,13 @@ void hvox::ai::NaiveNavmeshStrategy<IsSolid>::do_stitch(
                                neighbour_stitch_state, ChunkState::ACTIVE
                            ))
                 {
-                    std::shared_lock<std::shared_mutex> right_neighbour_block_lock;
-                    auto                                right_neighbour_blocks
-                        = right_neighbour->blocks.get(right_neighbour_block_lock);
-                    std::shared_lock<std::shared_mutex>
-                         below_right_neighbour_block_lock;
-                    auto below_right_neighbour_blocks
+                    BlockSnapshotHandle right_neighbour_block_snapshot;
+                    auto&               right_neighbour_blocks
+                        = right_neighbour->blocks.get(right_neighbour_block_snapshot);
+                    BlockSnapshotHandle below_right_neighbour_block_snapshot;
+                    auto&               below_right_neighbour_blocks
                         = below_right_neighbour->blocks.get(
-                            below_right_neighbour_block_lock
+                            below_right_neighbour_block_snapshot
                         );
 
                     // Step up from y == CHUNK_LENGTH - 2
@@ -5307,8 +5446,8 @@ void hvox::ai::NaiveNavmeshStrategy<IsSolid>::do_stitch(
 
             // Front
             {
-                auto front_neighbour       = chunk->neighbours.one.front.lock();
-                auto below_front_neighbour = neighbour->neighbours.one.front.lock();
+                auto front_neighbour       = chunk->neighbour(ChunkFace::FRONT);
+                auto below_front_neighbour = chunk->neighbour(0, -1, 1);
                 ChunkState neighbour_stitch_state = ChunkState::NONE;
                 if (front_neighbour != nullptr && below_front_neighbour != nullptr
                     && front_neighbour->bulk_navmeshing.load() == ChunkState::COMPLETE
@@ -5319,14 +5458,13 @@ void hvox::ai::NaiveNavmeshStrategy<IsSolid>::do_stitch(
                                neighbour_stitch_state, ChunkState::ACTIVE
                            ))
                 {
-                    std::shared_lock<std::shared_mutex> front_neighbour_block_lock;
-                    auto                                front_neighbour_blocks
-                        = front_neighbour->blocks.get(front_neighbour_block_lock);
-                    std::shared_lock<std::shared_mutex>
-                         below_front_neighbour_block_lock;
-                    auto below_front_neighbour_blocks
+                    BlockSnapshotHandle front_neighbour_block_snapshot;
+                    auto&               front_neighbour_blocks
+                        = front_neighbour->blocks.get(front_neighbour_block_snapshot);
+                    BlockSnapshotHandle below_front_neighbour_block_snapshot;
+                    auto&               below_front_neighbour_blocks
                         = below_front_neighbour->blocks.get(
-                            below_front_neighbour_block_lock
+                            below_front_neighbour_block_snapshot
                         );
 
                     // Step up from y == CHUNK_LENGTH - 2
@@ -5587,8 +5725,8 @@ void hvox::ai::NaiveNavmeshStrategy<IsSolid>::do_stitch(
 
             // Back
             {
-                auto       back_neighbour       = chunk->neighbours.one.back.lock();
-                auto       below_back_neighbour = neighbour->neighbours.one.back.lock();
+                auto       back_neighbour       = chunk->neighbour(ChunkFace::BACK);
+                auto       below_back_neighbour = chunk->neighbour(0, -1, -1);
                 ChunkState neighbour_stitch_state = ChunkState::NONE;
                 if (back_neighbour != nullptr && below_back_neighbour != nullptr
                     && back_neighbour->bulk_navmeshing.load() == ChunkState::COMPLETE
@@ -5599,14 +5737,14 @@ void hvox::ai::NaiveNavmeshStrategy<IsSolid>::do_stitch(
                                neighbour_stitch_state, ChunkState::ACTIVE
                            ))
                 {
-                    std::shared_lock<std::shared_mutex> back_neighbour_block_lock,
-                        below_back_neighbour_block_lock;
+                    BlockSnapshotHandle back_neighbour_block_snapshot,
+                        below_back_neighbour_block_snapshot;
                     auto& below_back_neighbour_blocks
                         = below_back_neighbour->blocks.get(
-                            below_back_neighbour_block_lock
+                            below_back_neighbour_block_snapshot
                         );
                     auto& back_neighbour_blocks
-                        = back_neighbour->blocks.get(back_neighbour_block_lock);
+                        = back_neighbour->blocks.get(back_neighbour_block_snapshot);
 
                     // Step up from y == CHUNK_LENGTH - 2
                     for (BlockChunkPositionCoord x = 0; x < CHUNK_LENGTH; ++x) {
@@ -5860,8 +5998,4 @@ void hvox::ai::NaiveNavmeshStrategy<IsSolid>::do_stitch(
             neighbour->navmesh_stitch.top.store(ChunkState::COMPLETE);
         }
     }
-
-    chunk->navmeshing.store(ChunkState::COMPLETE, std::memory_order_release);
-
-    chunk->on_navmesh_change();
 }
@@ -3,15 +3,41 @@
 
 #include "graphics/mesh.h"
 
+// NOTE(Matthew): The width of block IDs is chosen at build time, as every scan
+//                over a chunk's blocks (meshing, navmeshing, ray casting,
+//                collision) is bound by how many bytes each block takes up.
+//                Games should pick the narrowest width that covers the number
+//                of distinct blocks they need. The default stays at 64 bits,
+//                so that no existing game's IDs are truncated; narrower widths
+//                are opted into.
+#if !defined(HEMLOCK_BLOCK_ID_BITS)
+#    define HEMLOCK_BLOCK_ID_BITS 64
+#endif
+
 namespace hemlock {
     namespace voxel {
+#if HEMLOCK_BLOCK_ID_BITS == 8
+        using BlockID = ui8;
+#elif HEMLOCK_BLOCK_ID_BITS == 16
+        using BlockID = ui16;
+#elif HEMLOCK_BLOCK_ID_BITS == 32
+        using BlockID = ui32;
+#elif HEMLOCK_BLOCK_ID_BITS == 64
         using BlockID = ui64;
+#else
+#    error "HEMLOCK_BLOCK_ID_BITS must be one of 8, 16, 32 or 64."
+#endif
 
         struct Block {
             BlockID id;
             // more stuff
         };
 
+        static_assert(
+            sizeof(Block) == sizeof(BlockID),
+            "Block should be no wider than its ID, else block scans waste bandwidth."
+        );
+
         const Block NULL_BLOCK = Block{ 0 };
 
         const ui32 BLOCK_VERTEX_COUNT = 36;
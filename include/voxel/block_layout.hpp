@@ -0,0 +1,269 @@
+#ifndef __hemlock_voxel_block_layout_hpp
+#define __hemlock_voxel_block_layout_hpp
+
+#include "voxel/chunk/constants.hpp"
+#include "voxel/coordinate_system.h"
+
+#ifndef BLOCK_BRICK_LENGTH
+#  define BLOCK_BRICK_LENGTH 4
+#endif
+
+namespace hemlock {
+    namespace voxel {
+        /**
+         * @brief The orders in which the blocks of a chunk may be laid out in
+         * memory.
+         *
+         * LINEAR lays blocks out in rows along x, then y, then z. MORTON
+         * interleaves the bits of each coordinate (Z-order), so that blocks
+         * close to one another along any axis are close in memory. TILED
+         * lays out bricks of BLOCK_BRICK_LENGTH^3 blocks contiguously, blocks
+         * being linear within each brick and bricks being linear across the
+         * chunk.
+         */
+        enum class BlockLayout : ui8 {
+            LINEAR,
+            MORTON,
+            TILED
+        };
+
+        // NOTE(Matthew): As with block ID width, layout is chosen at build time
+        //                so that indexing stays as cheap as it can be; all
+        //                consumers go through block_index and the helpers in
+        //                face_check.hpp rather than assuming a layout.
+#if defined(HEMLOCK_BLOCK_LAYOUT_MORTON)
+        constexpr BlockLayout BLOCK_LAYOUT = BlockLayout::MORTON;
+#elif defined(HEMLOCK_BLOCK_LAYOUT_TILED)
+        constexpr BlockLayout BLOCK_LAYOUT = BlockLayout::TILED;
+#else
+        constexpr BlockLayout BLOCK_LAYOUT = BlockLayout::LINEAR;
+#endif
+
+        namespace impl {
+            constexpr ui32 log_2(ui32 value) {
+                ui32 result = 0;
+                while (value >>= 1) ++result;
+                return result;
+            }
+
+            constexpr bool is_power_2(ui32 value) {
+                return value != 0 && (value & (value - 1)) == 0;
+            }
+
+            constexpr ui32 CHUNK_LENGTH_BITS = log_2(CHUNK_LENGTH);
+            constexpr ui32 BRICK_LENGTH_BITS = log_2(BLOCK_BRICK_LENGTH);
+
+            /**
+             * @brief Gets the bit of a block index that holds the given bit
+             * of the coordinate on the given axis (0 = x, 1 = y, 2 = z).
+             */
+            template <BlockLayout Layout>
+            constexpr ui32 index_bit(ui32 axis, ui32 bit) {
+                if constexpr (Layout == BlockLayout::MORTON) {
+                    return bit * 3 + axis;
+                } else if constexpr (Layout == BlockLayout::TILED) {
+                    if (bit < BRICK_LENGTH_BITS) return axis * BRICK_LENGTH_BITS + bit;
+
+                    return 3 * BRICK_LENGTH_BITS
+                           + axis * (CHUNK_LENGTH_BITS - BRICK_LENGTH_BITS)
+                           + (bit - BRICK_LENGTH_BITS);
+                } else {
+                    return axis * CHUNK_LENGTH_BITS + bit;
+                }
+            }
+
+            /**
+             * @brief Table of the block index bits held by each coordinate
+             * value along one axis, such that a block's index is the OR of
+             * the entries for each of its coordinates.
+             */
+            struct DepositTable {
+                BlockIndex bits[CHUNK_LENGTH];
+                BlockIndex mask;
+            };
+
+            template <BlockLayout Layout, ui32 Axis>
+            constexpr DepositTable make_deposit_table() {
+                // NOTE(Matthew): Tables for the linear layout are only built so
+                //                that layout-generic code compiles, they are
+                //                never used to index.
+                static_assert(
+                    Layout == BlockLayout::LINEAR || is_power_2(CHUNK_LENGTH),
+                    "Bit-packed block layouts need a power of 2 chunk length."
+                );
+                static_assert(
+                    Layout != BlockLayout::TILED
+                        || (is_power_2(BLOCK_BRICK_LENGTH)
+                            && BLOCK_BRICK_LENGTH <= CHUNK_LENGTH),
+                    "Tiled block layout needs a power of 2 brick length no longer "
+                    "than a chunk."
+                );
+
+                DepositTable table{};
+                for (ui32 coord = 0; coord < CHUNK_LENGTH; ++coord) {
+                    table.bits[coord] = 0;
+                    for (ui32 bit = 0; bit < CHUNK_LENGTH_BITS; ++bit) {
+                        if ((coord >> bit) & 1)
+                            table.bits[coord] |= BlockIndex{ 1 }
+                                                 << index_bit<Layout>(Axis, bit);
+                    }
+                }
+                table.mask = table.bits[CHUNK_LENGTH - 1];
+                return table;
+            }
+
+            template <BlockLayout Layout, ui32 Axis>
+            inline constexpr DepositTable DEPOSIT = make_deposit_table<Layout, Axis>();
+
+            template <BlockLayout Layout, ui32 Axis>
+            inline BlockChunkPositionCoord extract(BlockIndex index) {
+                ui32 coord = 0;
+                for (ui32 bit = 0; bit < CHUNK_LENGTH_BITS; ++bit)
+                    coord |= ((index >> index_bit<Layout>(Axis, bit)) & 1) << bit;
+                return static_cast<BlockChunkPositionCoord>(coord);
+            }
+        }  // namespace impl
+
+        /**
+         * @brief Gets the mask of the bits of a block index that hold the
+         * coordinate on the given axis (0 = x, 1 = y, 2 = z). Only meaningful
+         * for power of 2 chunk lengths.
+         */
+        template <ui32 Axis, BlockLayout Layout = BLOCK_LAYOUT>
+        constexpr BlockIndex block_index_axis_mask() {
+            return impl::DEPOSIT<Layout, Axis>.mask;
+        }
+
+        /**
+         * @brief Converts a block's chunk position into its index into the
+         * chunk's block array under the given layout.
+         *
+         * @param position The position of the block within the chunk.
+         * @return BlockIndex The index of the block under the layout.
+         */
+        template <BlockLayout Layout = BLOCK_LAYOUT>
+        inline BlockIndex layout_block_index(BlockChunkPosition position) {
+            if constexpr (Layout == BlockLayout::LINEAR) {
+                return static_cast<BlockIndex>(position.x)
+                       + static_cast<BlockIndex>(position.y) * CHUNK_LENGTH
+                       + static_cast<BlockIndex>(position.z) * (CHUNK_AREA);
+            } else {
+                return impl::DEPOSIT<Layout, 0>.bits[position.x]
+                       | impl::DEPOSIT<Layout, 1>.bits[position.y]
+                       | impl::DEPOSIT<Layout, 2>.bits[position.z];
+            }
+        }
+
+        /**
+         * @brief Converts a block's index into the chunk's block array under
+         * the given layout into its chunk position.
+         *
+         * @param index The index of the block under the layout.
+         * @return BlockChunkPosition The position of the block within the
+         * chunk.
+         */
+        template <BlockLayout Layout = BLOCK_LAYOUT>
+        inline BlockChunkPosition layout_block_chunk_position(BlockIndex index) {
+            if constexpr (Layout == BlockLayout::LINEAR) {
+                return { static_cast<BlockChunkPositionCoord>(index % CHUNK_LENGTH),
+                         static_cast<BlockChunkPositionCoord>(
+                             (index / CHUNK_LENGTH) % CHUNK_LENGTH
+                         ),
+                         static_cast<BlockChunkPositionCoord>(index / (CHUNK_AREA)) };
+            } else {
+                return { impl::extract<Layout, 0>(index),
+                         impl::extract<Layout, 1>(index),
+                         impl::extract<Layout, 2>(index) };
+            }
+        }
+
+        /**
+         * @brief Visits every block of a chunk in the order they are laid
+         * out in memory.
+         *
+         * @param visitor Called with the index and chunk position of each
+         * block.
+         */
+        template <BlockLayout Layout = BLOCK_LAYOUT, typename Visitor>
+        void for_each_block(Visitor visitor) {
+            for (BlockIndex index = 0; index < (CHUNK_VOLUME); ++index)
+                visitor(index, layout_block_chunk_position<Layout>(index));
+        }
+
+        /**
+         * @brief Visits every block in the cuboid with the given inclusive
+         * start and end positions. Under the linear and tiled layouts blocks
+         * are visited in the order they are laid out in memory, as they are
+         * under the Morton layout unless the cuboid is so thin that scanning
+         * its index range would be wasteful.
+         *
+         * @param start The starting position of the cuboid.
+         * @param end The end position of the cuboid.
+         * @param visitor Called with the index and chunk position of each
+         * block.
+         */
+        template <BlockLayout Layout = BLOCK_LAYOUT, typename Visitor>
+        void for_each_block_in(
+            BlockChunkPosition start, BlockChunkPosition end, Visitor visitor
+        ) {
+            auto visit_rows = [&](BlockChunkPosition from, BlockChunkPosition to) {
+                for (ui32 z = from.z; z <= to.z; ++z) {
+                    for (ui32 y = from.y; y <= to.y; ++y) {
+                        for (ui32 x = from.x; x <= to.x; ++x) {
+                            BlockChunkPosition position{ x, y, z };
+                            visitor(layout_block_index<Layout>(position), position);
+                        }
+                    }
+                }
+            };
+
+            if constexpr (Layout == BlockLayout::MORTON) {
+                // Every block within the cuboid has an index between those of
+                // its corners, so we can walk that range and skip any outside.
+                const BlockIndex first = layout_block_index<Layout>(start);
+                const BlockIndex last  = layout_block_index<Layout>(end);
+                const ui32       volume
+                    = (1 + end.x - start.x) * (1 + end.y - start.y)
+                      * (1 + end.z - start.z);
+
+                if (last - first + 1 > 4 * volume) return visit_rows(start, end);
+
+                for (BlockIndex index = first; index <= last; ++index) {
+                    BlockChunkPosition position
+                        = layout_block_chunk_position<Layout>(index);
+                    if (glm::all(glm::greaterThanEqual(position, start))
+                        && glm::all(glm::lessThanEqual(position, end)))
+                        visitor(index, position);
+                }
+            } else if constexpr (Layout == BlockLayout::TILED) {
+                const BlockChunkPosition first_brick = start / BlockChunkPosition{
+                    BLOCK_BRICK_LENGTH
+                };
+                const BlockChunkPosition last_brick
+                    = end / BlockChunkPosition{ BLOCK_BRICK_LENGTH };
+
+                for (ui32 bz = first_brick.z; bz <= last_brick.z; ++bz) {
+                    for (ui32 by = first_brick.y; by <= last_brick.y; ++by) {
+                        for (ui32 bx = first_brick.x; bx <= last_brick.x; ++bx) {
+                            BlockChunkPosition brick_start
+                                = BlockChunkPosition{ bx, by, bz }
+                                  * BlockChunkPosition{ BLOCK_BRICK_LENGTH };
+                            BlockChunkPosition brick_end
+                                = brick_start
+                                  + BlockChunkPosition{ BLOCK_BRICK_LENGTH - 1 };
+
+                            visit_rows(
+                                glm::max(brick_start, start), glm::min(brick_end, end)
+                            );
+                        }
+                    }
+                }
+            } else {
+                visit_rows(start, end);
+            }
+        }
+    }  // namespace voxel
+}  // namespace hemlock
+namespace hvox = hemlock::voxel;
+
+#endif  // __hemlock_voxel_block_layout_hpp
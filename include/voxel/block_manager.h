@@ -3,21 +3,199 @@
 
 #include "thread/resource_guard.hpp"
 #include "voxel/block.hpp"
+#include "voxel/block_storage.h"
 #include "voxel/chunk/constants.hpp"
 
 namespace hemlock {
     namespace voxel {
-        using ChunkBlockPager = hmem::Pager<Block, CHUNK_VOLUME, 3>;
+        /**
+         * @brief A version of a chunk's blocks. The block manager of the
+         * chunk holds the latest version, which it writes to in place only
+         * while no reader holds it. Once handed to a reader, a snapshot is
+         * never written to, so may be read without any lock.
+         */
+        class BlockSnapshot {
+            friend class BlockManager;
+        public:
+            BlockSnapshot(hmem::Handle<ChunkBlockPager> block_pager, ui64 version);
+            ~BlockSnapshot();
+
+            BlockSnapshot(const BlockSnapshot&)            = delete;
+            BlockSnapshot& operator=(const BlockSnapshot&) = delete;
+
+            const BlockBuffer& blocks() const { return m_blocks; }
+
+            ui64 version() const { return m_version; }
+        protected:
+            BlockBuffer                   m_blocks;
+            ui64                          m_version;
+            hmem::Handle<ChunkBlockPager> m_block_pager;
+        };
+
+        using BlockSnapshotHandle = hmem::Handle<const BlockSnapshot>;
 
-        class BlockManager : public hthread::ResourceGuard<Block*> {
+        /**
+         * @brief Manages the blocks of a chunk, copy-on-write. The manager
+         * holds the latest version of the blocks as a snapshot, which
+         * readers share without locking or copying. Only a write made while
+         * a reader still holds the latest version copies it, leaving the
+         * reader's snapshot as it was.
+         */
+        class BlockManager :
+            public hthread::ResourceGuard<hmem::Handle<BlockSnapshot>> {
         public:
-            void init(hmem::Handle<ChunkBlockPager> block_pager);
+            BlockManager() : m_version(0) { /* Empty. */
+            }
+
+            void init(
+                hmem::Handle<ChunkBlockPager> block_pager,
+                BlockStorageKind              storage_kind = BlockStorageKind::RAW
+            );
             void dispose();
 
             void generate_buffer();
             void free_buffer();
+
+            BlockStorageKind storage_kind() const { return m_storage_kind; }
+
+            /**
+             * @brief Gets the block buffer for writing, marking the chunk's
+             * blocks as changed such that the next snapshot taken is of the
+             * buffer as it is once the lock is released. Should a reader
+             * hold a snapshot of the buffer as it is, the buffer is first
+             * copied.
+             *
+             * @param lock The lock to hold on the buffer.
+             * @return BlockBuffer& The block buffer.
+             */
+            BlockBuffer& get(std::unique_lock<std::shared_mutex>& lock);
+            /**
+             * @brief Gets the block buffer for reading.
+             *
+             * @param lock The lock to hold on the buffer.
+             * @return const BlockBuffer& The block buffer.
+             */
+            const BlockBuffer& get(std::shared_lock<std::shared_mutex>& lock);
+
+            /**
+             * @brief Gets the blocks of a snapshot of the latest version of
+             * the chunk's blocks, see snapshot.
+             *
+             * @param snapshot Set to the snapshot, which must be held for as
+             * long as the returned blocks are used.
+             * @return const BlockBuffer& The blocks of the snapshot.
+             */
+            const BlockBuffer& get(BlockSnapshotHandle& snapshot);
+
+            /**
+             * @brief Gets a snapshot of the latest version of the chunk's
+             * blocks, without copying them. Unless the blocks were written
+             * since last handed out, this takes no lock; otherwise it takes
+             * a shared lock, which waits only on writes in progress, not on
+             * other readers.
+             *
+             * @return BlockSnapshotHandle The snapshot.
+             */
+            BlockSnapshotHandle snapshot();
+            /**
+             * @brief Takes the latest version of the chunk's blocks out of
+             * the manager, without copying them. The manager is left holding
+             * a uniform buffer of NULL_BLOCK, and any page taken is returned
+             * to the pager once the snapshot is released.
+             *
+             * @return BlockSnapshotHandle The snapshot taken.
+             */
+            BlockSnapshotHandle take();
+
+            /**
+             * @brief The version of the chunk's blocks, which changes each
+             * time the block buffer is got for writing.
+             */
+            ui64 version() const { return m_version.load(std::memory_order_acquire); }
+
+            /**
+             * @brief Makes the block buffer uniform, releasing its page or
+             * palette, if every block in it is the same.
+             *
+             * @return True if the buffer is uniform after the call, false
+             * otherwise.
+             */
+            bool collapse_if_uniform();
+
+            /**
+             * @brief Compresses the block buffer into palette storage if it
+             * is held raw and the palette would be smaller, see
+             * BlockBuffer::compress. Snapshots already held are kept by their
+             * readers, but no longer shared with new ones.
+             *
+             * @return True if the buffer was compressed, false otherwise.
+             */
+            bool compress();
+            /**
+             * @brief Decompresses the block buffer back into raw storage if
+             * it was compressed, see BlockBuffer::decompress.
+             *
+             * @return True if the buffer was decompressed, false otherwise.
+             */
+            bool decompress();
+
+            /**
+             * @brief Whether every block of the chunk is the same block. This
+             * takes a shared lock on the buffer, so must not be called while
+             * holding a lock on it.
+             */
+            bool is_uniform();
+
+            /**
+             * @brief The number of bytes held by this manager's block buffer.
+             * This takes a shared lock on the buffer, so must not be called
+             * while holding a lock on it.
+             */
+            size_t allocated_bytes();
+            /**
+             * @brief The number of bytes held by the latest version of the
+             * chunk's blocks to have been copied away from, if a reader still
+             * holds it. This takes a shared lock on the buffer, so must not
+             * be called while holding a lock on it.
+             */
+            size_t snapshot_bytes();
         protected:
+            /**
+             * @brief Replaces the block buffer with a fresh, uniform one, of
+             * a new version. Must be called with the lock held for writing.
+             */
+            void replace_buffer();
+            /**
+             * @brief Gets the block buffer such that it may be written to,
+             * copying it if a reader holds it. Must be called with the lock
+             * held for writing.
+             */
+            BlockBuffer& exclusive_buffer();
+
+            BlockSnapshotHandle load_published();
+            void                store_published(const BlockSnapshotHandle& snapshot);
+
             hmem::Handle<ChunkBlockPager> m_block_pager;
+            BlockStorageKind              m_storage_kind = BlockStorageKind::RAW;
+
+            std::atomic<ui64> m_version;
+
+            // The latest version of the blocks copied away from while a reader
+            // held it, held weakly so that its page goes once no reader does.
+            hmem::WeakHandle<const BlockSnapshot> m_superseded;
+
+            // The block buffer as handed out to readers, which is the buffer
+            // itself unless written to since, and nullptr otherwise.
+#if defined(__cpp_lib_atomic_shared_ptr)
+            std::atomic<BlockSnapshotHandle> m_published;
+#else
+            // NOTE(Matthew): Where the standard library lacks
+            //                std::atomic<std::shared_ptr>, the published
+            //                buffer is guarded by a mutex of its own, held
+            //                only to copy it.
+            std::mutex          m_published_mutex;
+            BlockSnapshotHandle m_published;
+#endif
         };
     }  // namespace voxel
 }  // namespace hemlock
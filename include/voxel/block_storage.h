@@ -0,0 +1,285 @@
+#ifndef __hemlock_voxel_block_storage_h
+#define __hemlock_voxel_block_storage_h
+
+#include "voxel/block.hpp"
+#include "voxel/chunk/constants.hpp"
+#include "voxel/coordinate_system.h"
+
+namespace hemlock {
+    namespace voxel {
+        using ChunkBlockPager = hmem::Pager<Block, CHUNK_VOLUME, 3>;
+
+        /**
+         * @brief The kinds of storage a chunk's blocks may be held in.
+         *
+         * RAW stores one Block per block index in a page obtained from the
+         * chunk block pager. PALETTE stores each distinct block once in a
+         * per-chunk palette, with each block index holding a bit-packed index
+         * into that palette. UNIFORM stores a single Block that every block
+         * index holds; it is never requested directly, rather buffers start
+         * out uniform and may return to being so.
+         */
+        enum class BlockStorageKind : ui8 {
+            RAW,
+            PALETTE,
+            UNIFORM
+        };
+
+        /**
+         * @brief Palette-compressed block storage. Each block index holds a
+         * 1, 2, 4, 8 or 16-bit index into a palette of distinct blocks, the
+         * width of which is widened as more distinct blocks are written.
+         */
+        class PaletteBlockStorage {
+        public:
+            PaletteBlockStorage() :
+                m_bits(0), m_mask(0), m_last_entry(0) { /* Empty. */
+            }
+
+            /**
+             * @brief Prepares storage for a chunk entirely made up of the
+             * given block.
+             *
+             * @param block The block the chunk initially consists of.
+             */
+            void init(Block block = NULL_BLOCK);
+            /**
+             * @brief Releases all memory held by the storage.
+             */
+            void dispose();
+
+            /**
+             * @brief Gets the block at the given index.
+             *
+             * @param index The index of the block to get.
+             * @return const Block& The block at the given index, this
+             * reference remains valid until the storage is next written to.
+             */
+            const Block& get(BlockIndex index) const {
+                return m_palette[read_entry(index)];
+            }
+
+            /**
+             * @brief Sets the block at the given index.
+             *
+             * @param index The index of the block to set.
+             * @param block The block to set.
+             */
+            void set(BlockIndex index, Block block);
+
+            /**
+             * @brief Sets all blocks of the chunk to the given block,
+             * shrinking the storage back to its narrowest width.
+             *
+             * @param block The block to set.
+             */
+            void reset(Block block);
+
+            /**
+             * @brief The number of bits used per block index.
+             */
+            ui8 index_bits() const { return m_bits; }
+
+            /**
+             * @brief The number of blocks in the palette still in use.
+             */
+            size_t palette_size() const;
+
+            /**
+             * @brief The number of bytes allocated by this storage.
+             */
+            size_t allocated_bytes() const;
+        protected:
+            ui32 read_entry(BlockIndex index) const {
+                const ui32 bit = index * static_cast<ui32>(m_bits);
+                return static_cast<ui32>((m_indices[bit >> 6] >> (bit & 63)) & m_mask);
+            }
+
+            void write_entry(BlockIndex index, ui32 entry) {
+                const ui32 bit   = index * static_cast<ui32>(m_bits);
+                ui64&      word  = m_indices[bit >> 6];
+                const ui32 shift = bit & 63;
+
+                word = (word & ~(m_mask << shift))
+                       | ((static_cast<ui64>(entry) & m_mask) << shift);
+            }
+
+            /**
+             * @brief Finds the palette entry of the given block, adding it
+             * to the palette if it is not yet present.
+             */
+            ui32 find_or_add_entry(Block block);
+
+            /**
+             * @brief Doubles the number of bits used per block index,
+             * repacking all indices.
+             */
+            void widen();
+
+            std::vector<Block> m_palette;
+            std::vector<ui32>  m_counts;
+            std::vector<ui64>  m_indices;
+            ui8                m_bits;
+            ui64               m_mask;
+            ui32               m_last_entry;
+        };
+
+        /**
+         * @brief The block buffer of a chunk, backed by whichever block
+         * storage the owning block manager was initialised with. While
+         * every block of the chunk is the same, the buffer holds just that
+         * block, only taking on its backing storage once a differing block
+         * is written.
+         */
+        class BlockBuffer {
+            friend class BlockManager;
+            friend class BlockSnapshot;
+        public:
+            BlockBuffer() :
+                m_kind(BlockStorageKind::UNIFORM),
+                m_backing_kind(BlockStorageKind::RAW),
+                m_uniform(NULL_BLOCK),
+                m_raw(nullptr),
+                m_block_pager(nullptr) { /* Empty. */
+            }
+
+            BlockBuffer(const BlockBuffer&)            = delete;
+            BlockBuffer& operator=(const BlockBuffer&) = delete;
+
+            BlockStorageKind kind() const { return m_kind; }
+
+            bool is_uniform() const { return m_kind == BlockStorageKind::UNIFORM; }
+
+            /**
+             * @brief The number of bytes held by the buffer, be it a page of
+             * raw blocks or a palette.
+             */
+            size_t allocated_bytes() const;
+
+            /**
+             * @brief Gets the block at the given index.
+             *
+             * @param index The index of the block to get.
+             * @return const Block& The block at the given index, this
+             * reference remains valid until the buffer is next written to.
+             */
+            const Block& operator[](BlockIndex index) const {
+                switch (m_kind) {
+                    case BlockStorageKind::RAW:
+                        return m_raw[index];
+                    case BlockStorageKind::PALETTE:
+                        return m_palette.get(index);
+                    default:
+                        return m_uniform;
+                }
+            }
+
+            /**
+             * @brief Sets the block at the given index.
+             *
+             * @param index The index of the block to set.
+             * @param block The block to set.
+             */
+            void set(BlockIndex index, Block block) {
+                if (m_kind == BlockStorageKind::UNIFORM) {
+                    if (block == m_uniform) return;
+
+                    expand();
+                }
+
+                if (m_kind == BlockStorageKind::RAW) {
+                    m_raw[index] = block;
+                } else {
+                    m_palette.set(index, block);
+                }
+            }
+
+            /**
+             * @brief Sets all blocks in the cuboid with the given inclusive
+             * start and end positions to the given block. If the cuboid
+             * spans the whole chunk, the buffer becomes uniform.
+             *
+             * @param start The starting position of the range to set.
+             * @param end The end position of the range to set.
+             * @param block The block to set.
+             */
+            void fill(BlockChunkPosition start, BlockChunkPosition end, Block block);
+            /**
+             * @brief Sets all blocks in the cuboid with the given start and
+             * end positions to each block in a buffer. Note, the buffer is
+             * assumed to go in x, then y, then z starting from the near
+             * bottom left of the cuboid.
+             *
+             * @param start The starting position of the range to set.
+             * @param end The end position of the range to set.
+             * @param blocks The blocks to set.
+             */
+            void copy(BlockChunkPosition start, BlockChunkPosition end, Block* blocks);
+
+            /**
+             * @brief Makes the buffer uniform, releasing its backing
+             * storage, if every block in it is the same.
+             *
+             * @return True if the buffer is uniform after the call, false
+             * otherwise.
+             */
+            bool collapse_if_uniform();
+
+            /**
+             * @brief Moves a buffer held in raw storage into palette
+             * storage, releasing its page, if the palette would take up
+             * less memory. The buffer keeps its backing kind, so it may
+             * later be decompressed.
+             *
+             * @return True if the buffer was compressed, false otherwise.
+             */
+            bool compress();
+            /**
+             * @brief Moves a buffer compressed into palette storage back
+             * into raw storage, if that is its backing kind.
+             *
+             * @return True if the buffer was decompressed, false otherwise.
+             */
+            bool decompress();
+
+            /**
+             * @brief The raw page of blocks, or nullptr if this buffer is
+             * not held in raw storage.
+             */
+            Block* raw() { return m_kind == BlockStorageKind::RAW ? m_raw : nullptr; }
+
+            /**
+             * @brief The raw page of blocks, or nullptr if this buffer is
+             * not held in raw storage.
+             */
+            const Block* raw() const {
+                return m_kind == BlockStorageKind::RAW ? m_raw : nullptr;
+            }
+        protected:
+            /**
+             * @brief Moves a uniform buffer into its backing storage, with
+             * every block set to the uniform block.
+             */
+            void expand();
+            /**
+             * @brief Releases any backing storage and makes the buffer
+             * uniform with the given block.
+             */
+            void make_uniform(Block block);
+            /**
+             * @brief Makes this buffer a copy of the given buffer, taking a
+             * page of its own if the given buffer holds one.
+             */
+            void copy_from(const BlockBuffer& source);
+
+            BlockStorageKind    m_kind, m_backing_kind;
+            Block               m_uniform;
+            Block*              m_raw;
+            PaletteBlockStorage m_palette;
+            ChunkBlockPager*    m_block_pager;
+        };
+    }  // namespace voxel
+}  // namespace hemlock
+namespace hvox = hemlock::voxel;
+
+#endif  // __hemlock_voxel_block_storage_h
@@ -8,12 +8,15 @@
 #include "voxel/block.hpp"
 #include "voxel/block_manager.h"
 #include "voxel/chunk/constants.hpp"
+#include "voxel/chunk/dirty_region.hpp"
+#include "voxel/chunk/edits.hpp"
 #include "voxel/chunk/event/block_change.hpp"
 #include "voxel/chunk/event/bulk_block_change.hpp"
 #include "voxel/chunk/event/lod_change.hpp"
 #include "voxel/chunk/event/render_distance_change.hpp"
 #include "voxel/chunk/state.hpp"
 #include "voxel/coordinate_system.h"
+#include "voxel/generation/column_cache.h"
 #include "voxel/graphics/mesh/instance_manager.h"
 #include "voxel/task.hpp"
 
@@ -30,15 +33,75 @@ namespace hemlock {
                 hmem::WeakHandle<Chunk>              self,
                 hmem::Handle<ChunkBlockPager>        block_pager,
                 hmem::Handle<ChunkInstanceDataPager> instance_data_pager,
-                hmem::Handle<ai::ChunkNavmeshPager>  navmesh_pager
+                hmem::Handle<ai::ChunkNavmeshPager>  navmesh_pager,
+                BlockStorageKind block_storage_kind = BlockStorageKind::RAW
             );
 
             void update(FrameTime);
 
             ChunkID id() const { return position.id; }
 
+            /**
+             * @brief Marks the cuboid with the given inclusive start and end
+             * positions as changed, such that meshing and navmeshing may be
+             * limited to it. Where the cuboid reaches a face of the chunk, the
+             * facing blocks of the neighbour across it are marked for meshing
+             * too. Outside of generation, the cuboid's blocks are also noted
+             * as edits, see ChunkEdits.
+             *
+             * NOTE: Must be called with the lock on the chunk's blocks held
+             *       for writing.
+             *
+             * @param start The starting position of the cuboid.
+             * @param end The end position of the cuboid.
+             */
+            void mark_dirty(BlockChunkPosition start, BlockChunkPosition end);
+
+            /**
+             * @brief Completes the generation of the chunk once its blocks
+             * have been set, whether generated or loaded: collapses its
+             * blocks if uniform, marks it dirty whole, lets each loaded
+             * neighbour know it is generated and triggers on_load.
+             */
+            void complete_generation();
+
+            /**
+             * @brief Gets the neighbour of the chunk with the given index,
+             * see Neighbours::all.
+             *
+             * @param index The index of the neighbour.
+             * @return The neighbour if loaded, nullptr otherwise.
+             */
+            hmem::Handle<Chunk> neighbour(ui8 index);
+            /**
+             * @brief Gets the neighbour of the chunk across the given face.
+             *
+             * @param face The face across which the neighbour lies.
+             * @return The neighbour if loaded, nullptr otherwise.
+             */
+            hmem::Handle<Chunk> neighbour(ChunkFace face) {
+                return neighbour(static_cast<ui8>(face));
+            }
+
+            /**
+             * @brief Gets the neighbour of the chunk at the given offset in
+             * chunks, see neighbour_index.
+             *
+             * @return The neighbour if loaded, nullptr otherwise.
+             */
+            hmem::Handle<Chunk> neighbour(i32 dx, i32 dy, i32 dz) {
+                return neighbour(neighbour_index(dx, dy, dz));
+            }
+
             ChunkGridPosition position;
+            // Guards the chunk's neighbours, which are linked and unlinked by
+            // the grid while tasks read them. Held too as the chunk publishes
+            // its generation as complete, such that a neighbour linked at the
+            // same time either sees it complete or is told of it.
+            std::shared_mutex neighbours_mutex;
             Neighbours        neighbours;
+            // Which neighbours are loaded and which of those have been generated.
+            NeighbourStates generated_neighbours;
 
             BlockManager blocks;
 
@@ -48,10 +111,40 @@ namespace hemlock {
 
             ChunkInstanceManager instance;
 
+            // Blocks changed since the chunk was last meshed and navmeshed, and
+            // since its column metadata was last updated.
+            struct {
+                ChunkDirtyRegion mesh, navmesh, column;
+            } dirty;
+
+            // Blocks changed since the chunk was generated, guarded by the lock
+            // on its blocks.
+            ChunkEdits edits;
+
+            // Products of generation passes shared by every chunk of the
+            // chunk's column, set by the grid as the chunk is created.
+            hmem::Handle<ColumnGenerationData> column_data;
+
+            // Incremented whenever all tasks queued for the chunk are to be
+            // cancelled, tasks capture it when built and are dropped if it has
+            // since changed.
+            std::atomic<ui32> task_epoch;
+
+            // The version of the chunk's blocks when last generated, loaded or
+            // saved, the chunk need only be saved if its blocks have changed
+            // since.
+            std::atomic<ui64> saved_version;
+
+            // The level of detail the chunk is meshed at, see ChunkRenderer.
             std::atomic<LODLevel>   lod_level;
             std::atomic<ChunkState> generation, meshing, mesh_uploading,
                 bulk_navmeshing, navmeshing;
 
+            // Whether a mesh of the chunk was dropped as its neighbours were not
+            // yet generated, in which case it is requested again as each of them
+            // is generated or unloaded.
+            std::atomic<bool> mesh_deferred;
+
             struct {
                 std::atomic<ChunkState> right, top, front, above_left, above_right,
                     above_front, above_back, above_and_across_left,
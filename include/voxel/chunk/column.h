@@ -0,0 +1,156 @@
+#ifndef __hemlock_voxel_chunk_column_h
+#define __hemlock_voxel_chunk_column_h
+
+#include "voxel/chunk/constants.hpp"
+#include "voxel/coordinate_system.h"
+
+namespace hemlock {
+    namespace voxel {
+        struct Chunk;
+
+        /**
+         * @brief What a chunk is made of, as far as solidity goes. A block
+         * is considered solid here if it is anything but NULL_BLOCK.
+         */
+        enum class ChunkContent : ui8 {
+            UNKNOWN,
+            EMPTY,
+            MIXED,
+            SOLID
+        };
+
+        static_assert(
+            CHUNK_LENGTH < 256, "Column summaries hold heights and counts in a byte."
+        );
+
+        /**
+         * @brief Summary of the blocks of one chunk of a column, with each
+         * (x, z) of the chunk indexed as x + z * CHUNK_LENGTH.
+         */
+        struct ChunkColumnSummary {
+            hmem::WeakHandle<Chunk> chunk;
+            // Whether the chunk's blocks have been scanned at all.
+            bool scanned = false;
+            // One more than the y of the highest solid block, 0 if none.
+            ui8  heights[CHUNK_AREA]      = {};
+            ui8  solid_counts[CHUNK_AREA] = {};
+            ui32 solid_count              = 0;
+        };
+
+        /**
+         * @brief Metadata of the loaded chunks of a column.
+         */
+        struct ColumnMetadata {
+            ColumnMetadata();
+
+            // The world y of the highest solid block of each (x, z) of the
+            // column among its loaded chunks.
+            BlockWorldPositionCoord heights[CHUNK_AREA];
+            // Summaries of the loaded chunks of the column, by grid y.
+            std::map<i64, ChunkColumnSummary> chunks;
+        };
+
+        /**
+         * @brief Keeps metadata of each column of chunks held by a chunk
+         * grid: the highest solid block of each (x, z), and whether each
+         * chunk is empty, solid or mixed. This lets surface queries be
+         * answered without searching the column, and lets work on chunks
+         * with nothing in them be skipped.
+         *
+         * A chunk's summary is built by scanning its blocks once generated,
+         * after which only the (x, z) within its dirty column region are
+         * rescanned on each update.
+         *
+         * NOTE: Only the thread owning the chunk grid may add or remove
+         * chunks. Any thread may update chunks or query the cache.
+         */
+        class ColumnMetadataCache {
+        public:
+            static constexpr BlockWorldPositionCoord NO_SURFACE
+                = std::numeric_limits<BlockWorldPositionCoord>::min();
+
+            ColumnMetadataCache() { /* Empty. */
+            }
+
+            ~ColumnMetadataCache() { /* Empty. */
+            }
+
+            /**
+             * @brief Disposes of the cache, dropping all metadata.
+             */
+            void dispose();
+
+            /**
+             * @brief Adds the given chunk to its column. Its content stays
+             * unknown until it is first updated.
+             *
+             * @param chunk The chunk to add.
+             */
+            void add_chunk(hmem::Handle<Chunk> chunk);
+            /**
+             * @brief Removes the chunk at the given position from its
+             * column, dropping the column if no other chunk of it is
+             * loaded.
+             *
+             * @param chunk_position The position of the chunk to remove.
+             */
+            void remove_chunk(ChunkGridPosition chunk_position);
+
+            /**
+             * @brief Rescans the blocks of the given chunk that have changed
+             * since it was last updated, or all of its blocks if it has not
+             * yet been scanned. Chunks not added to the cache are ignored.
+             *
+             * @param chunk The chunk to update.
+             */
+            void update_chunk(hmem::Handle<Chunk> chunk);
+
+            /**
+             * @brief Gets what the chunk at the given position is made of.
+             *
+             * @param chunk_position The position of the chunk.
+             * @return ChunkContent The content of the chunk, UNKNOWN if it
+             * is not loaded or not yet scanned.
+             */
+            ChunkContent content(ChunkGridPosition chunk_position) const;
+
+            /**
+             * @brief Gets the world y of the highest solid block at the
+             * given world x and z among loaded chunks.
+             *
+             * @param x The world x of the block column.
+             * @param z The world z of the block column.
+             * @param height Set to the y of the highest solid block.
+             * @return True if a solid block was found, false otherwise, in
+             * which case height is left untouched.
+             */
+            bool surface_height(
+                BlockWorldPositionCoord x,
+                BlockWorldPositionCoord z,
+                OUT BlockWorldPositionCoord& height
+            ) const;
+
+            size_t column_count() const;
+        protected:
+            /**
+             * @brief Recalculates the heights of the given column for each
+             * (x, z) in the rectangle with the given inclusive bounds.
+             */
+            void refresh_heights(
+                ColumnMetadata&    column,
+                BlockChunkPosition start,
+                BlockChunkPosition end
+            );
+
+            // Held by adds, removes and updates, so that an update never
+            // works from a summary that changes under it.
+            std::mutex m_update_mutex;
+
+            mutable std::shared_mutex                    m_columns_mutex;
+            std::unordered_map<ColumnID, ColumnMetadata> m_columns;
+        };
+    }  // namespace voxel
+}  // namespace hemlock
+namespace hvox = hemlock::voxel;
+
+#endif  // __hemlock_voxel_chunk_column_h
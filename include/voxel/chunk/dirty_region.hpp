@@ -0,0 +1,152 @@
+#ifndef __hemlock_voxel_chunk_dirty_region_hpp
+#define __hemlock_voxel_chunk_dirty_region_hpp
+
+#include "voxel/chunk/constants.hpp"
+#include "voxel/coordinate_system.h"
+
+namespace hemlock {
+    namespace voxel {
+        /**
+         * @brief The faces of a chunk, in the order of the neighbours held in
+         * Neighbours::all.
+         */
+        enum class ChunkFace : ui8 {
+            LEFT   = 0,
+            RIGHT  = 1,
+            TOP    = 2,
+            BOTTOM = 3,
+            FRONT  = 4,
+            BACK   = 5
+        };
+
+        /**
+         * @brief Gets the mask of the faces of a chunk reached by the cuboid
+         * with the given inclusive start and end positions, with bit N set
+         * for face N of ChunkFace.
+         *
+         * @param start The starting position of the cuboid.
+         * @param end The end position of the cuboid.
+         * @return ui8 The mask of faces reached.
+         */
+        inline ui8 faces_reached(BlockChunkPosition start, BlockChunkPosition end) {
+            ui8 faces = 0;
+            if (start.x == 0) faces |= 1 << static_cast<ui8>(ChunkFace::LEFT);
+            if (end.x == CHUNK_LENGTH - 1)
+                faces |= 1 << static_cast<ui8>(ChunkFace::RIGHT);
+            if (end.y == CHUNK_LENGTH - 1)
+                faces |= 1 << static_cast<ui8>(ChunkFace::TOP);
+            if (start.y == 0) faces |= 1 << static_cast<ui8>(ChunkFace::BOTTOM);
+            if (end.z == CHUNK_LENGTH - 1)
+                faces |= 1 << static_cast<ui8>(ChunkFace::FRONT);
+            if (start.z == 0) faces |= 1 << static_cast<ui8>(ChunkFace::BACK);
+            return faces;
+        }
+
+        /**
+         * @brief Tracks the cuboid of a chunk's blocks that has changed since
+         * the work depending on those blocks was last done, so that the work
+         * may be limited to that cuboid.
+         *
+         * Marking and consuming are lock-free, so setters and tasks on any
+         * thread may use the region concurrently. A region that has never
+         * been marked since last consumed says nothing of what changed, and
+         * so consumers should treat it as the whole chunk.
+         */
+        class ChunkDirtyRegion {
+        public:
+            ChunkDirtyRegion() : m_packed(0) { /* Empty. */
+            }
+
+            /**
+             * @brief Grows the region to include the cuboid with the given
+             * inclusive start and end positions.
+             *
+             * @param start The starting position of the cuboid.
+             * @param end The end position of the cuboid.
+             */
+            void mark(BlockChunkPosition start, BlockChunkPosition end) {
+                ui64 packed = m_packed.load(std::memory_order_relaxed);
+                ui64 merged;
+                do {
+                    merged = pack(start, end);
+                    if (packed & DIRTY_BIT) {
+                        BlockChunkPosition dirty_start, dirty_end;
+                        unpack(packed, dirty_start, dirty_end);
+
+                        merged = pack(
+                            glm::min(start, dirty_start), glm::max(end, dirty_end)
+                        );
+                    }
+                } while (!m_packed.compare_exchange_weak(
+                    packed, merged, std::memory_order_acq_rel, std::memory_order_relaxed
+                ));
+            }
+
+            /**
+             * @brief Grows the region to include the whole chunk.
+             */
+            void mark_all() {
+                mark(BlockChunkPosition{ 0 }, BlockChunkPosition{ CHUNK_LENGTH - 1 });
+            }
+
+            /**
+             * @brief Empties the region.
+             */
+            void clear() { m_packed.store(0, std::memory_order_release); }
+
+            bool is_dirty() const {
+                return (m_packed.load(std::memory_order_acquire) & DIRTY_BIT) != 0;
+            }
+
+            /**
+             * @brief Takes the region, leaving it clean.
+             *
+             * @param start Set to the starting position of the region.
+             * @param end Set to the end position of the region.
+             * @return True if the region had been marked, false otherwise,
+             * in which case start and end are left untouched.
+             */
+            bool consume(BlockChunkPosition& start, BlockChunkPosition& end) {
+                ui64 packed = m_packed.exchange(0, std::memory_order_acq_rel);
+                if (!(packed & DIRTY_BIT)) return false;
+
+                unpack(packed, start, end);
+                return true;
+            }
+        protected:
+            static constexpr ui64 COORD_BITS = 8 * sizeof(BlockChunkPositionCoord);
+            static constexpr ui64 COORD_MASK = (ui64{ 1 } << COORD_BITS) - 1;
+            static constexpr ui64 DIRTY_BIT  = ui64{ 1 } << 63;
+
+            static_assert(
+                6 * COORD_BITS < 64, "Chunk dirty regions must pack into 63 bits."
+            );
+
+            static ui64 pack(BlockChunkPosition start, BlockChunkPosition end) {
+                return DIRTY_BIT | static_cast<ui64>(start.x)
+                       | static_cast<ui64>(start.y) << COORD_BITS
+                       | static_cast<ui64>(start.z) << (2 * COORD_BITS)
+                       | static_cast<ui64>(end.x) << (3 * COORD_BITS)
+                       | static_cast<ui64>(end.y) << (4 * COORD_BITS)
+                       | static_cast<ui64>(end.z) << (5 * COORD_BITS);
+            }
+
+            static void
+            unpack(ui64 packed, BlockChunkPosition& start, BlockChunkPosition& end) {
+                auto coord = [packed](ui64 n) {
+                    return static_cast<BlockChunkPositionCoord>(
+                        (packed >> (n * COORD_BITS)) & COORD_MASK
+                    );
+                };
+
+                start = { coord(0), coord(1), coord(2) };
+                end   = { coord(3), coord(4), coord(5) };
+            }
+
+            std::atomic<ui64> m_packed;
+        };
+    }  // namespace voxel
+}  // namespace hemlock
+namespace hvox = hemlock::voxel;
+
+#endif  // __hemlock_voxel_chunk_dirty_region_hpp
@@ -0,0 +1,97 @@
+#ifndef __hemlock_voxel_chunk_edit_batch_h
+#define __hemlock_voxel_chunk_edit_batch_h
+
+#include "voxel/block.hpp"
+#include "voxel/coordinate_system.h"
+
+namespace hemlock {
+    namespace voxel {
+        struct Chunk;
+
+        /**
+         * @brief A single edit within a block edit batch, setting all blocks
+         * in the cuboid with the given inclusive start and end positions to
+         * the given block.
+         */
+        struct BlockEdit {
+            BlockChunkPosition start, end;
+            Block              block;
+        };
+
+        /**
+         * @brief Collects block edits across any number of chunks so that
+         * they may be applied together. On commit, each chunk's edits are
+         * applied in the order they were made under a single write lock,
+         * with one bulk block change event being triggered for each chunk
+         * rather than one event per edit.
+         *
+         * NOTE: Like the free setters, a batch should only be committed from
+         * a context where the chunks it edits are not being written to by a
+         * generation task.
+         */
+        class BlockEditBatch {
+        public:
+            BlockEditBatch() { /* Empty. */
+            }
+
+            ~BlockEditBatch() { /* Empty. */
+            }
+
+            /**
+             * @brief Queues setting a single block of the passed in chunk.
+             *
+             * @param chunk The chunk in which to set the block.
+             * @param position The position of the block to set.
+             * @param block The block to set.
+             */
+            void set_block(
+                hmem::Handle<Chunk> chunk, BlockChunkPosition position, Block block
+            );
+
+            /**
+             * @brief Queues setting all points in a rectangular cuboid of the
+             * passed in chunk to a specific block.
+             *
+             * @param chunk The chunk in which to set the blocks.
+             * @param start The starting position of the range to set blocks for.
+             * @param end The end position of the range to set blocks for.
+             * @param block The block to set.
+             */
+            void set_blocks(
+                hmem::Handle<Chunk> chunk,
+                BlockChunkPosition  start,
+                BlockChunkPosition  end,
+                Block               block
+            );
+
+            /**
+             * @brief Applies all queued edits, chunk by chunk, and empties the
+             * batch. Edits to a chunk are skipped wholesale if any subscriber
+             * to its bulk block change event cancels them.
+             *
+             * @return The number of chunks whose edits were applied.
+             */
+            ui32 commit();
+
+            /**
+             * @brief Drops all queued edits without applying them.
+             */
+            void clear() { m_chunk_edits.clear(); }
+
+            bool empty() const { return m_chunk_edits.empty(); }
+
+            size_t chunk_count() const { return m_chunk_edits.size(); }
+        protected:
+            struct ChunkEdits {
+                hmem::Handle<Chunk>    chunk;
+                std::vector<BlockEdit> edits;
+                BlockChunkPosition     start, end;
+            };
+
+            std::unordered_map<ChunkID, ChunkEdits> m_chunk_edits;
+        };
+    }  // namespace voxel
+}  // namespace hemlock
+namespace hvox = hemlock::voxel;
+
+#endif  // __hemlock_voxel_chunk_edit_batch_h
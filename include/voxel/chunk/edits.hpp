@@ -0,0 +1,100 @@
+#ifndef __hemlock_voxel_chunk_edits_hpp
+#define __hemlock_voxel_chunk_edits_hpp
+
+#include "voxel/block_layout.hpp"
+#include "voxel/chunk/constants.hpp"
+#include "voxel/coordinate_system.h"
+
+namespace hemlock {
+    namespace voxel {
+        /**
+         * @brief Tracks which blocks of a chunk have been changed since it
+         * was generated, such that the chunk may be saved as just those
+         * blocks and loaded by generating it again and setting them anew.
+         *
+         * Once more blocks are changed than are worth saving one by one,
+         * the edits overflow and say only that the chunk must be saved
+         * whole.
+         *
+         * NOTE: Edits are not synchronised themselves, they are guarded by
+         *       the lock on the blocks of the chunk they belong to.
+         */
+        struct ChunkEdits {
+            // Beyond this many changed blocks, a chunk is saved whole, as an
+            // index and block per changed block is then more than its runs
+            // take for most chunks.
+            static constexpr size_t MAX_EDITS = CHUNK_VOLUME / 8;
+
+            ChunkEdits() : overflowed(false) { /* Empty. */
+            }
+
+            /**
+             * @brief Marks the blocks in the cuboid with the given inclusive
+             * start and end positions as changed.
+             *
+             * @param start The starting position of the cuboid.
+             * @param end The end position of the cuboid.
+             */
+            void mark(BlockChunkPosition start, BlockChunkPosition end) {
+                if (overflowed) return;
+
+                const size_t volume = static_cast<size_t>(end.x - start.x + 1)
+                                      * static_cast<size_t>(end.y - start.y + 1)
+                                      * static_cast<size_t>(end.z - start.z + 1);
+                if (volume > MAX_EDITS) {
+                    mark_all();
+                    return;
+                }
+
+                for_each_block_in(
+                    start,
+                    end,
+                    [&](BlockIndex index, BlockChunkPosition) {
+                        indices.push_back(static_cast<ui16>(index));
+                    }
+                );
+
+                if (indices.size() <= MAX_EDITS) return;
+
+                // The same blocks are often changed over and over, so only
+                // overflow if there are too many once duplicates are gone.
+                std::sort(indices.begin(), indices.end());
+                indices.erase(
+                    std::unique(indices.begin(), indices.end()), indices.end()
+                );
+
+                if (indices.size() > MAX_EDITS) mark_all();
+            }
+
+            /**
+             * @brief Marks every block of the chunk as changed.
+             */
+            void mark_all() {
+                overflowed = true;
+                std::vector<ui16>().swap(indices);
+            }
+
+            /**
+             * @brief Forgets every change, as when the chunk is generated
+             * anew.
+             */
+            void reset() {
+                overflowed = false;
+                std::vector<ui16>().swap(indices);
+            }
+
+            /**
+             * @brief Whether the chunk may be saved as just its changed
+             * blocks.
+             */
+            bool is_delta() const { return !overflowed; }
+
+            // The indices of blocks changed, possibly with duplicates.
+            std::vector<ui16> indices;
+            bool              overflowed;
+        };
+    }  // namespace voxel
+}  // namespace hemlock
+namespace hvox = hemlock::voxel;
+
+#endif  // __hemlock_voxel_chunk_edits_hpp
@@ -6,12 +6,24 @@
 namespace hemlock {
     namespace voxel {
         struct Block;
+        struct BlockEdit;
 
+        /**
+         * @brief Describes a change to many blocks of a chunk at once. Either
+         * a cuboid is filled with a single block or with a buffer of blocks,
+         * or, if edits is not nullptr, the given edits are applied in order,
+         * all falling within the cuboid given by start and end position.
+         *
+         * NOTE: The end position is inclusive, it is the last position of
+         *       the cuboid changed, whichever way the change is made.
+         */
         struct BulkBlockChangeEvent {
             Block*             new_blocks;
             bool               single_block;
             BlockChunkPosition start_position;
             BlockChunkPosition end_position;
+            const BlockEdit*   edits      = nullptr;
+            size_t             edit_count = 0;
         };
     }  // namespace voxel
 }  // namespace hemlock
@@ -5,8 +5,15 @@
 #include "timing.h"
 #include "voxel/ai/navmesh/navmesh_manager.h"
 #include "voxel/chunk/chunk.h"
+#include "voxel/chunk/column.h"
+#include "voxel/chunk/registry.h"
+#include "voxel/chunk/residency.h"
+#include "voxel/chunk/scheduler.h"
 #include "voxel/coordinate_system.h"
+#include "voxel/generation/column_cache.h"
 #include "voxel/graphics/renderer.h"
+#include "voxel/io/region_file.h"
+#include "voxel/io/save_queue.h"
 #include "voxel/task.hpp"
 
 // TODO(Matthew): Do we want to make Grid and Chunk composable? Or else some other way
@@ -22,9 +29,8 @@ namespace hemlock {
         //                as it may be nice to base this on view distance.
         using ChunkAllocator = hmem::PagedAllocator<Chunk, 4 * 4 * 4, 3>;
 
-        using Chunks = std::unordered_map<ChunkID, hmem::Handle<Chunk>>;
-
-        using ChunkTaskBuilder = Delegate<ChunkTask*(void)>;
+        using ChunkTaskBuilder       = Delegate<ChunkTask*(void)>;
+        using ChunkColumnTaskBuilder = Delegate<ChunkColumnTask*(void)>;
 
         class ChunkGrid {
         public:
@@ -48,6 +54,8 @@ namespace hemlock {
              * task to mesh a chunk.
              * @param build_navmesh_task Builder that returns a valid
              * task to navmesh a chunk.
+             * @param block_storage_kind The kind of storage chunks of
+             * this grid hold their blocks in.
              */
             void init(
                 hmem::WeakHandle<ChunkGrid> self,
@@ -55,7 +63,8 @@ namespace hemlock {
                 ui32                        thread_count,
                 ChunkTaskBuilder            build_load_or_generate_task,
                 ChunkTaskBuilder            build_mesh_task,
-                ChunkTaskBuilder*           build_navmesh_task = nullptr
+                ChunkTaskBuilder*           build_navmesh_task = nullptr,
+                BlockStorageKind            block_storage_kind = BlockStorageKind::RAW
             );
             /**
              * @brief Disposes of the chunk grid, ending
@@ -85,6 +94,14 @@ namespace hemlock {
                 return m_chunks_in_render_distance;
             }
 
+            BlockStorageKind block_storage_kind() const { return m_block_storage_kind; }
+
+            hmem::Handle<ChunkBlockPager> block_pager() const { return m_block_pager; }
+
+            hmem::Handle<ChunkInstanceDataPager> instance_pager() const {
+                return m_instance_pager;
+            }
+
             /**
              * @brief Suspends chunk tasks. This is a hammer, but
              * for testing it can definitely be useful. Probably
@@ -100,12 +117,133 @@ namespace hemlock {
 
             ChunkRenderer* renderer() { return &m_renderer; }
 
+            /**
+             * @brief Sets the store chunks are saved to once changed and
+             * unloaded, and that chunks are loaded from before being
+             * generated. The store is not owned by the grid and must
+             * outlive it, or be unset first.
+             *
+             * @param region_store The store, nullptr if chunks are not to
+             * be saved or loaded.
+             */
+            void set_region_store(ChunkRegionStore* region_store) {
+                m_region_store = region_store;
+            }
+
+            ChunkRegionStore* region_store() const { return m_region_store; }
+
+            /**
+             * @brief Sets the queue chunks are saved through once changed
+             * and unloaded, rather than being saved to the region store
+             * directly, which should be the store the queue writes to. The
+             * queue is not owned by the grid, which updates it, and must
+             * outlive it, or be unset first.
+             *
+             * @param save_queue The queue, nullptr if chunks are to be
+             * saved to the region store directly.
+             */
+            void set_save_queue(ChunkSaveQueue* save_queue) {
+                m_save_queue = save_queue;
+            }
+
+            ChunkSaveQueue* save_queue() const { return m_save_queue; }
+
+            /**
+             * @brief Sets the manager keeping the memory held by the chunks
+             * of the grid within a budget. The grid updates the manager, and
+             * touches chunks through it as they are edited, ray cast through,
+             * or read by mesh and navmesh tasks, so that they are rehydrated
+             * once needed. The manager is not owned by the grid and must
+             * outlive it, or be unset first.
+             *
+             * @param residency_manager The manager, nullptr if chunks are
+             * not to be dehydrated.
+             */
+            void set_residency_manager(ChunkResidencyManager* residency_manager) {
+                m_residency_manager = residency_manager;
+            }
+
+            ChunkResidencyManager* residency_manager() const {
+                return m_residency_manager;
+            }
+
+            /**
+             * @brief Marks the chunk at the given position as needed by the
+             * residency manager, if one is set, such that what of it is
+             * needed is rehydrated on the next update if it was dehydrated.
+             * Safe to call from any thread.
+             *
+             * @param chunk_position The position of the chunk.
+             * @param needs The mask of what of the chunk is needed.
+             */
+            void touch_chunk(
+                ChunkGridPosition chunk_position,
+                ChunkDehydration  needs = ChunkDehydration::ALL
+            ) {
+                if (m_residency_manager)
+                    m_residency_manager->touch(chunk_position, needs);
+            }
+
+            /**
+             * @brief Sets the builder of tasks that load or generate a run
+             * of chunks stacked one on another in a column all at once, see
+             * ChunkColumnGenerationTask. With one set, chunks to be loaded
+             * are held until the next update, when those of each column
+             * that are stacked one on another are batched into tasks of at
+             * most the given number of chunks. Without one, each chunk is
+             * loaded by a task of its own.
+             *
+             * @param build_column_generation_task Builder that returns a
+             * valid task to load or generate a run of chunks, or nullptr
+             * to load each chunk alone.
+             * @param max_column_chunks The most chunks a task may be given.
+             */
+            void set_column_generation_task_builder(
+                ChunkColumnTaskBuilder* build_column_generation_task,
+                ui32                    max_column_chunks = 8
+            );
+
+            /**
+             * @brief Reads the record of the chunk at the given position as
+             * last saved, whether the save is still queued or written to
+             * the region store. Safe to call from any thread.
+             *
+             * @param chunk_position The position of the chunk.
+             * @param record Set to the chunk's record, see
+             * decode_chunk_record.
+             * @return True if the chunk's record was read, false if it has
+             * never been saved.
+             */
+            bool read_saved_record(
+                ChunkGridPosition chunk_position, OUT std::vector<ui8>& record
+            );
+
+            /**
+             * @brief Sets the points about which chunk tasks are
+             * prioritised, such that tasks for chunks nearest any of them
+             * are run first, and from which the renderer measures each
+             * chunk's distance to pick its level of detail. This is cheap
+             * to call every frame, priorities and levels of detail are only
+             * recalculated when a focus point moves into another chunk.
+             *
+             * @param focus_points The positions of the focus points, e.g.
+             * of the chunk holding the camera.
+             * @param focus_point_count The number of focus points.
+             */
+            void set_focus_points(
+                const ChunkGridPosition* focus_points, ui32 focus_point_count
+            ) {
+                m_scheduler.set_focus_points(focus_points, focus_point_count);
+                m_renderer.set_focus_points(focus_points, focus_point_count);
+            }
+
             /**
              * @brief Loads chunks with the assumption none specified
              * have even been preloaded. This is useful as it assures
              * all preloading is done before any loading so that there
              * is no need for corrective load tasks later for adjoining
-             * chunks etc.
+             * chunks etc. All load tasks are queued together once every
+             * chunk is preloaded.
              *
              * @param chunk_positions The array of chunk coords for which
              * to load chunks.
@@ -140,8 +278,8 @@ namespace hemlock {
             bool load_chunk_at(ChunkGridPosition chunk_position);
             /**
              * @brief Unloads a chunk, this entails ending all
-             * pending tasks for this chunk and releasing memory
-             * associated with it.
+             * pending tasks for this chunk, saving it if it has
+             * changed and releasing memory associated with it.
              *
              * NOTE: this is a non-blocking action, and the chunk
              * will only release memory once all active queries and
@@ -160,10 +298,58 @@ namespace hemlock {
                 ChunkGridPosition        chunk_position,
                 hmem::WeakHandle<Chunk>* handle = nullptr
             );
+            /**
+             * @brief Cancels all tasks queued for a chunk, such that
+             * they are dropped rather than run. Tasks already running
+             * are allowed to complete. A chunk whose load is cancelled
+             * before it began may be loaded again.
+             *
+             * @param chunk_position The coords of the chunk whose tasks
+             * to cancel.
+             * @return True if the chunk is held by the grid, false
+             * otherwise.
+             */
+            bool cancel_tasks(ChunkGridPosition chunk_position);
+
+            /**
+             * @brief Requests that the given chunk be meshed or
+             * navmeshed. At most one task of each kind is pending for
+             * a chunk at once, so if one is pending the request folds
+             * into it, and if one is running it is rerun once done.
+             * Whether a task is pending or running is given by the
+             * chunk's meshing and navmeshing states. Safe to call from
+             * any thread.
+             *
+             * @param chunk The chunk to mesh or navmesh.
+             * @param kind The kind of task, either MESH or NAVMESH.
+             * @return True if a new task was scheduled, false if the
+             * request was folded into one pending or running, or the
+             * grid doesn't do that kind of task.
+             */
+            bool request_chunk_task(hmem::Handle<Chunk> chunk, ChunkTaskKind kind);
+            /**
+             * @brief Schedules a task of the given kind for the given
+             * chunk whose state is already pending. Used by a task that
+             * finds it was requested again while it ran. Safe to call
+             * from any thread.
+             *
+             * @param chunk The chunk to mesh or navmesh.
+             * @param kind The kind of task, either MESH or NAVMESH.
+             */
+            void rerun_chunk_task(hmem::Handle<Chunk> chunk, ChunkTaskKind kind);
+            /**
+             * @brief Requests a mesh of the given chunk if one was dropped
+             * while waiting on its neighbours to be generated, see
+             * Chunk::mesh_deferred. Safe to call from any thread.
+             *
+             * @param chunk The chunk whose neighbours have changed.
+             */
+            void request_deferred_mesh(hmem::Handle<Chunk> chunk);
 
             /**
              * @brief Returns a handle on the identified chunk
-             * if it is held by the chunk grid.
+             * if it is held by the chunk grid. Safe to call from
+             * any thread.
              *
              * @param id The ID of the chunk to fetch.
              * @return hmem::Handle<Chunk> Handle on the
@@ -173,7 +359,8 @@ namespace hemlock {
 
             /**
              * @brief Returns a handle on the identified chunk
-             * if it is held by the chunk grid.
+             * if it is held by the chunk grid. Safe to call from
+             * any thread.
              *
              * @param position The position of the chunk.
              * @return hmem::Handle<Chunk> Handle on the
@@ -183,7 +370,19 @@ namespace hemlock {
                 return chunk(position.id);
             }
 
-            const Chunks& chunks() const { return m_chunks; }
+            /**
+             * @brief The chunks held by the grid. While chunks may be found in
+             * the registry from any thread, it may only be iterated from the
+             * thread that owns the grid.
+             */
+            const ChunkRegistry& chunks() const { return m_chunks; }
+
+            /**
+             * @brief The metadata of each column of chunks held by the grid,
+             * e.g. the surface height at each x and z, and which chunks are
+             * empty. Safe to query from any thread.
+             */
+            const ColumnMetadataCache& columns() const { return m_columns; }
 
             /**
              * @brief Triggered whenever the render distance of this chunk grid
@@ -191,14 +390,91 @@ namespace hemlock {
              */
             Event<RenderDistanceChangeEvent> on_render_distance_change;
         protected:
+            /**
+             * @brief Creates a chunk at the given position and registers it
+             * with the grid, without yet linking it to its neighbours.
+             *
+             * @param chunk_position The coords of the chunk to create.
+             * @return hmem::Handle<Chunk> The created chunk.
+             */
+            hmem::Handle<Chunk> register_chunk_at(ChunkGridPosition chunk_position);
+            /**
+             * @brief Links the given chunk with each of its loaded
+             * neighbours, across faces, edges and corners alike.
+             *
+             * @param chunk The chunk to link.
+             */
             void establish_chunk_neighbours(hmem::Handle<Chunk> chunk);
+            /**
+             * @brief Unlinks the given chunk from each of its neighbours,
+             * such that none of them holds a link to it any longer.
+             *
+             * @param chunk The chunk to unlink.
+             */
+            void unlink_chunk_neighbours(hmem::Handle<Chunk> chunk);
 
-            Delegate<void(Sender)>                   handle_chunk_load;
-            Delegate<bool(Sender, BlockChangeEvent)> handle_block_change;
+            /**
+             * @brief Notes that the blocks of the given chunk have changed,
+             * such that it is remeshed at the end of this update, along with
+             * any neighbour across a face that the change reaches.
+             *
+             * @param chunk The chunk whose blocks have changed.
+             * @param start The starting position of the changed cuboid.
+             * @param end The last position of the changed cuboid, inclusive.
+             */
+            void mark_chunk_changed(
+                hmem::WeakHandle<Chunk> chunk,
+                BlockChunkPosition      start,
+                BlockChunkPosition      end
+            );
+            /**
+             * @brief Updates the column metadata of, and requests one mesh
+             * task, and one navmesh task if navmeshing, for each chunk marked
+             * as changed since the last update.
+             */
+            void schedule_changed_chunks();
+
+            /**
+             * @brief Schedules the given chunk, whose generation was just
+             * made pending, to be loaded or generated. With a column
+             * generation task builder set, the chunk is held until the next
+             * update to be batched with others of its column.
+             *
+             * @param chunk The chunk to load or generate.
+             */
+            void schedule_generation(hmem::Handle<Chunk> chunk);
+            /**
+             * @brief Batches the chunks held to be loaded or generated into
+             * tasks of runs of chunks stacked one on another in a column,
+             * and schedules them.
+             */
+            void schedule_column_generation();
+
+            /**
+             * @brief Saves the given chunk as it is unloaded, if it is
+             * generated and its blocks have changed since last generated,
+             * loaded or saved. With a save queue, the chunk's blocks and
+             * edits are handed to it without being copied, otherwise they
+             * are saved to the region store there and then.
+             *
+             * @param chunk The chunk to save.
+             * @return True if the chunk was saved or queued to be, false
+             * otherwise.
+             */
+            bool save_unloaded_chunk(hmem::Handle<Chunk> chunk);
+
+            Delegate<void(Sender)>                       handle_chunk_load;
+            Delegate<bool(Sender, BlockChangeEvent)>     handle_block_change;
+            Delegate<bool(Sender, BulkBlockChangeEvent)> handle_bulk_block_change;
+            Delegate<void(Sender, LODChangeEvent)>       handle_lod_change;
 
             ChunkTaskBuilder m_build_load_or_generate_task, m_build_mesh_task,
                 m_build_navmesh_task;
+            ChunkColumnTaskBuilder           m_build_column_generation_task;
+            ui32                             m_max_column_chunks;
+            std::vector<hmem::Handle<Chunk>> m_pending_generation;
             thread::ThreadPool<ChunkTaskContext> m_thread_pool;
+            ChunkTaskScheduler                   m_scheduler;
 
             ChunkAllocator m_chunk_allocator;
 
@@ -206,10 +482,22 @@ namespace hemlock {
             hmem::Handle<ChunkInstanceDataPager> m_instance_pager;
             hmem::Handle<ai::ChunkNavmeshPager>  m_navmesh_pager;
 
+            BlockStorageKind m_block_storage_kind;
+
             ChunkRenderer m_renderer;
             ui32          m_render_distance, m_chunks_in_render_distance;
 
-            Chunks m_chunks;
+            ChunkRegistry         m_chunks;
+            ColumnMetadataCache   m_columns;
+            ColumnGenerationCache m_column_generation_cache;
+
+            ChunkRegionStore* m_region_store = nullptr;
+            ChunkSaveQueue*   m_save_queue   = nullptr;
+
+            ChunkResidencyManager* m_residency_manager = nullptr;
+
+            std::mutex                                           m_changed_chunks_mutex;
+            std::unordered_map<ChunkID, hmem::WeakHandle<Chunk>> m_changed_chunks;
 
             hmem::WeakHandle<ChunkGrid> m_self;
         };
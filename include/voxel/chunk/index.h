@@ -0,0 +1,199 @@
+#ifndef __hemlock_voxel_chunk_index_h
+#define __hemlock_voxel_chunk_index_h
+
+#include "voxel/coordinate_system.h"
+
+namespace hemlock {
+    namespace voxel {
+        struct Chunk;
+
+        struct ChunkIndexEntry {
+            ChunkID             id;
+            hmem::Handle<Chunk> chunk;
+        };
+
+        /**
+         * @brief Index of the chunks held by a chunk grid.
+         *
+         * Chunks are held in a dense, toroidal cube of slots, each chunk
+         * going in the slot given by its grid position modulo the length of
+         * the cube. So long as the chunks loaded fit within a cube of that
+         * length, as those within render distance of a single point do, each
+         * has a slot to itself and lookups are a single array read. Any chunk
+         * whose slot is already taken is instead held in an overflow map
+         * until that slot is freed.
+         *
+         * An index may be told that the chunks it holds all share the same
+         * lowest few bits of their position along each axis, as is the case
+         * for the shards of a chunk registry, such that those bits are
+         * skipped over in finding slots.
+         */
+        class ChunkIndex {
+        public:
+            /**
+             * @brief Iterates all chunks in the index, those held in slots
+             * first, in the order of the slots, followed by those overflowed.
+             */
+            class const_iterator {
+                friend class ChunkIndex;
+
+                using OverflowIterator
+                    = std::unordered_map<ChunkID, ChunkIndexEntry>::const_iterator;
+            public:
+                using iterator_category = std::forward_iterator_tag;
+                using value_type        = ChunkIndexEntry;
+                using difference_type   = std::ptrdiff_t;
+                using pointer           = const ChunkIndexEntry*;
+                using reference         = const ChunkIndexEntry&;
+
+                const_iterator() : m_index(nullptr), m_slot(0) { /* Empty. */
+                }
+
+                reference operator*() const {
+                    if (m_slot < m_index->m_slots.size())
+                        return m_index->m_slots[m_slot];
+
+                    return m_overflow->second;
+                }
+
+                pointer operator->() const { return &**this; }
+
+                const_iterator& operator++();
+
+                const_iterator operator++(int) {
+                    const_iterator tmp = *this;
+                    ++*this;
+                    return tmp;
+                }
+
+                bool operator==(const const_iterator& rhs) const {
+                    return m_slot == rhs.m_slot && m_overflow == rhs.m_overflow;
+                }
+            protected:
+                const_iterator(
+                    const ChunkIndex* index, size_t slot, OverflowIterator overflow
+                ) :
+                    m_index(index), m_slot(slot), m_overflow(overflow) { /* Empty. */
+                }
+
+                /**
+                 * @brief Moves on to the next occupied slot at or after the
+                 * current one, if any.
+                 */
+                void skip_empty_slots();
+
+                const ChunkIndex* m_index;
+                size_t            m_slot;
+                OverflowIterator  m_overflow;
+            };
+
+            /**
+             * @param stride_bits The number of lowest bits of each axis of
+             * the positions of chunks held that are the same for all chunks.
+             */
+            ChunkIndex(ui32 stride_bits = 0);
+
+            ~ChunkIndex() { /* Empty. */
+            }
+
+            /**
+             * @brief Resizes the cube of slots, moving all chunks held into
+             * their new slots.
+             *
+             * @param min_length The length of cube needed, the cube used is
+             * of the next power of 2 at least as long.
+             */
+            void resize(ui32 min_length);
+
+            /**
+             * @brief Releases all chunks held.
+             */
+            void clear();
+
+            /**
+             * @brief Finds the chunk at the given position.
+             *
+             * @param position The position of the chunk.
+             * @return hmem::Handle<Chunk> The chunk if held, nullptr otherwise.
+             */
+            hmem::Handle<Chunk> find(ChunkGridPosition position) const {
+                const ChunkIndexEntry& entry = m_slots[slot_of(position)];
+                if (entry.chunk != nullptr && entry.id == position.id)
+                    return entry.chunk;
+
+                if (m_overflow.empty()) return nullptr;
+
+                auto it = m_overflow.find(position.id);
+                if (it == m_overflow.end()) return nullptr;
+
+                return it->second.chunk;
+            }
+
+            /**
+             * @brief Finds the identified chunk.
+             *
+             * @param id The ID of the chunk.
+             * @return hmem::Handle<Chunk> The chunk if held, nullptr otherwise.
+             */
+            hmem::Handle<Chunk> find(ChunkID id) const {
+                ChunkGridPosition position;
+                position.id = id;
+                return find(position);
+            }
+
+            /**
+             * @brief Adds the given chunk at the given position.
+             *
+             * @param position The position of the chunk.
+             * @param chunk The chunk to add.
+             * @return True if the chunk was added, false if a chunk is
+             * already held at the position.
+             */
+            bool insert(ChunkGridPosition position, hmem::Handle<Chunk> chunk);
+
+            /**
+             * @brief Removes the chunk at the given position.
+             *
+             * @param position The position of the chunk.
+             * @return hmem::Handle<Chunk> The chunk removed, nullptr if no
+             * chunk was held at the position.
+             */
+            hmem::Handle<Chunk> erase(ChunkGridPosition position);
+
+            size_t size() const { return m_size; }
+
+            bool empty() const { return m_size == 0; }
+
+            /**
+             * @brief The number of chunks held outside of the cube of slots.
+             */
+            size_t overflow_size() const { return m_overflow.size(); }
+
+            /**
+             * @brief The length of the cube of slots.
+             */
+            ui32 length() const { return 1 << m_length_bits; }
+
+            const_iterator begin() const;
+            const_iterator end() const;
+        protected:
+            size_t slot_of(ChunkGridPosition position) const {
+                const i64 mask = static_cast<i64>(length()) - 1;
+
+                return static_cast<size_t>(
+                    ((position.x >> m_stride_bits) & mask)
+                    | (((position.y >> m_stride_bits) & mask) << m_length_bits)
+                    | (((position.z >> m_stride_bits) & mask) << (2 * m_length_bits))
+                );
+            }
+
+            std::vector<ChunkIndexEntry>                 m_slots;
+            std::unordered_map<ChunkID, ChunkIndexEntry> m_overflow;
+            ui32                                         m_stride_bits, m_length_bits;
+            size_t                                       m_size;
+        };
+    }  // namespace voxel
+}  // namespace hemlock
+namespace hvox = hemlock::voxel;
+
+#endif  // __hemlock_voxel_chunk_index_h
@@ -0,0 +1,109 @@
+#ifndef __hemlock_voxel_chunk_lod_h
+#define __hemlock_voxel_chunk_lod_h
+
+#include "voxel/block_storage.h"
+#include "voxel/chunk/constants.hpp"
+#include "voxel/chunk/dirty_region.hpp"
+#include "voxel/chunk/event/lod_change.hpp"
+#include "voxel/coordinate_system.h"
+#include "voxel/graphics/mesh/instance_manager.h"
+
+namespace hemlock {
+    namespace voxel {
+        // The coarsest level of detail, at which each cell of 8x8x8 blocks
+        // of a chunk is represented by one block. Level 0 is full detail.
+        constexpr LODLevel MAX_LOD_LEVEL = 3;
+
+        static_assert(
+            (CHUNK_LENGTH >> MAX_LOD_LEVEL) << MAX_LOD_LEVEL == CHUNK_LENGTH,
+            "Chunks must split evenly into the cells of the coarsest level of detail."
+        );
+
+        /**
+         * @brief The length in blocks of each cell of a chunk at the given
+         * level of detail, i.e. 1, 2, 4 or 8.
+         */
+        inline ui32 lod_scale(LODLevel lod_level) {
+            return 1u << lod_level;
+        }
+
+        /**
+         * @brief The length in cells of a chunk at the given level of
+         * detail, i.e. 32, 16, 8 or 4.
+         */
+        inline ui32 lod_length(LODLevel lod_level) {
+            return CHUNK_LENGTH >> lod_level;
+        }
+
+        /**
+         * @brief Downsamples the given blocks to the cells of the given
+         * level of detail, one block per cell. Each cell becomes the block
+         * most common in it, or NULL_BLOCK if more than half of the cell is
+         * empty.
+         *
+         * @param blocks The blocks to downsample.
+         * @param lod_level The level of detail to downsample to.
+         * @param cells The buffer to write the cells to, lod_length^3 long,
+         * in rows along x, then y, then z.
+         */
+        void downsample_blocks(
+            const BlockBuffer& blocks, LODLevel lod_level, OUT Block* cells
+        );
+
+        /**
+         * @brief Downsamples the layer of cells of a chunk's neighbour across
+         * the given face of the chunk that borders it, e.g. the neighbour's
+         * rightmost layer for the left face.
+         *
+         * @param neighbour_blocks The blocks of the neighbour.
+         * @param lod_level The level of detail to downsample to.
+         * @param face The face of the chunk the neighbour is across.
+         * @param layer The buffer to write the cells to, lod_length^2 long,
+         * in rows along the first of x, y and z across the face, then the
+         * second.
+         */
+        void downsample_face(
+            const BlockBuffer& neighbour_blocks,
+            LODLevel           lod_level,
+            ChunkFace          face,
+            OUT Block*         layer
+        );
+
+        /**
+         * @brief Buffers to mesh a chunk at a level of detail in, kept by
+         * each thread so that they are reused from one chunk to the next.
+         */
+        struct LODMeshBuffers {
+            std::vector<Block> cells;
+            std::vector<Block> layers[6];
+        };
+
+        /**
+         * @brief Meshes a chunk from its cells at the given level of detail.
+         * A cell is exposed across a face if the cell beside it is
+         * NULL_BLOCK, whether that cell is in the chunk or, at the chunk's
+         * faces, in the neighbour's layer at the same level of detail. As
+         * at full detail, a cell is not exposed across a face of the chunk
+         * without a neighbour. Runs along x of exposed cells make one
+         * instance each.
+         *
+         * @param cells The chunk's cells, see downsample_blocks.
+         * @param layers For each face of the chunk, the layer of cells of
+         * the neighbour across it, see downsample_face, or nullptr if there
+         * is no neighbour.
+         * @param lod_level The level of detail of the cells.
+         * @param chunk_position The position of the chunk meshed.
+         * @param instance The instances to write, which must have a buffer.
+         */
+        void mesh_cells(
+            const Block*       cells,
+            const Block*       layers[6],
+            LODLevel           lod_level,
+            ChunkGridPosition  chunk_position,
+            OUT ChunkInstance& instance
+        );
+    }  // namespace voxel
+}  // namespace hemlock
+namespace hvox = hemlock::voxel;
+
+#endif  // __hemlock_voxel_chunk_lod_h
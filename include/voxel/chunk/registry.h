@@ -0,0 +1,171 @@
+#ifndef __hemlock_voxel_chunk_registry_h
+#define __hemlock_voxel_chunk_registry_h
+
+#include "voxel/chunk/index.h"
+#include "voxel/coordinate_system.h"
+
+namespace hemlock {
+    namespace voxel {
+        struct Chunk;
+
+        /**
+         * @brief Registry of the chunks held by a chunk grid, which may be
+         * searched from any thread.
+         *
+         * Chunks are split between shards by the lowest bits of their
+         * position along each axis, so that neighbouring chunks fall into
+         * different shards. Each shard is a chunk index guarded by its own
+         * lock, so finding a chunk takes only a shared lock on one shard and
+         * workers searching the registry rarely contend with one another or
+         * with the owning thread.
+         *
+         * NOTE: Only the owning thread may add or remove chunks, resize the
+         * registry, or iterate it. As no other thread changes the registry,
+         * the owning thread iterates it without locking.
+         */
+        class ChunkRegistry {
+        public:
+            static constexpr ui32 SHARD_BITS  = 1;
+            static constexpr ui32 SHARD_COUNT = 1 << (3 * SHARD_BITS);
+
+            /**
+             * @brief Iterates all chunks in the registry, shard by shard.
+             */
+            class const_iterator {
+                friend class ChunkRegistry;
+            public:
+                using iterator_category = std::forward_iterator_tag;
+                using value_type        = ChunkIndexEntry;
+                using difference_type   = std::ptrdiff_t;
+                using pointer           = const ChunkIndexEntry*;
+                using reference         = const ChunkIndexEntry&;
+
+                const_iterator() : m_registry(nullptr), m_shard(SHARD_COUNT) {
+                    // Empty.
+                }
+
+                reference operator*() const { return *m_entry; }
+
+                pointer operator->() const { return &*m_entry; }
+
+                const_iterator& operator++();
+
+                const_iterator operator++(int) {
+                    const_iterator tmp = *this;
+                    ++*this;
+                    return tmp;
+                }
+
+                bool operator==(const const_iterator& rhs) const {
+                    return m_shard == rhs.m_shard
+                           && (m_shard == SHARD_COUNT || m_entry == rhs.m_entry);
+                }
+            protected:
+                const_iterator(const ChunkRegistry* registry, ui32 shard) :
+                    m_registry(registry), m_shard(shard) { /* Empty. */
+                }
+
+                /**
+                 * @brief Moves on to the first chunk of the next non-empty
+                 * shard at or after the current one, if any.
+                 */
+                void skip_empty_shards();
+
+                const ChunkRegistry*       m_registry;
+                ui32                       m_shard;
+                ChunkIndex::const_iterator m_entry;
+            };
+
+            ChunkRegistry() { /* Empty. */
+            }
+
+            ~ChunkRegistry() { /* Empty. */
+            }
+
+            /**
+             * @brief Resizes the registry to hold a cube of chunks of the
+             * given length without overflowing.
+             *
+             * @param min_length The length of cube of chunks to hold.
+             */
+            void resize(ui32 min_length);
+
+            /**
+             * @brief Releases all chunks held.
+             */
+            void clear();
+
+            /**
+             * @brief Finds the chunk at the given position. Safe to call from
+             * any thread.
+             *
+             * @param position The position of the chunk.
+             * @return hmem::Handle<Chunk> The chunk if held, nullptr otherwise.
+             */
+            hmem::Handle<Chunk> find(ChunkGridPosition position) const {
+                const Shard& shard = m_shards[shard_of(position)];
+
+                std::shared_lock<std::shared_mutex> lock(shard.mutex);
+                return shard.index.find(position);
+            }
+
+            /**
+             * @brief Finds the identified chunk. Safe to call from any thread.
+             *
+             * @param id The ID of the chunk.
+             * @return hmem::Handle<Chunk> The chunk if held, nullptr otherwise.
+             */
+            hmem::Handle<Chunk> find(ChunkID id) const {
+                ChunkGridPosition position;
+                position.id = id;
+                return find(position);
+            }
+
+            /**
+             * @brief Adds the given chunk at the given position.
+             *
+             * @param position The position of the chunk.
+             * @param chunk The chunk to add.
+             * @return True if the chunk was added, false if a chunk is
+             * already held at the position.
+             */
+            bool insert(ChunkGridPosition position, hmem::Handle<Chunk> chunk);
+
+            /**
+             * @brief Removes the chunk at the given position.
+             *
+             * @param position The position of the chunk.
+             * @return hmem::Handle<Chunk> The chunk removed, nullptr if no
+             * chunk was held at the position.
+             */
+            hmem::Handle<Chunk> erase(ChunkGridPosition position);
+
+            size_t size() const { return m_size.load(std::memory_order_relaxed); }
+
+            bool empty() const { return size() == 0; }
+
+            const_iterator begin() const;
+            const_iterator end() const;
+        protected:
+            struct Shard {
+                mutable std::shared_mutex mutex;
+                ChunkIndex                index{ SHARD_BITS };
+            };
+
+            static size_t shard_of(ChunkGridPosition position) {
+                constexpr i64 MASK = (1 << SHARD_BITS) - 1;
+
+                return static_cast<size_t>(
+                    (position.x & MASK) | ((position.y & MASK) << SHARD_BITS)
+                    | ((position.z & MASK) << (2 * SHARD_BITS))
+                );
+            }
+
+            std::array<Shard, SHARD_COUNT> m_shards;
+            std::atomic<size_t>            m_size = 0;
+        };
+    }  // namespace voxel
+}  // namespace hemlock
+namespace hvox = hemlock::voxel;
+
+#endif  // __hemlock_voxel_chunk_registry_h
@@ -0,0 +1,185 @@
+#ifndef __hemlock_voxel_chunk_residency_h
+#define __hemlock_voxel_chunk_residency_h
+
+#include "voxel/coordinate_system.h"
+
+namespace hemlock {
+    namespace voxel {
+        class ChunkGrid;
+        struct Chunk;
+
+        /**
+         * @brief The memory held by the chunks of a grid, by what holds it.
+         * Snapshots are versions of chunks' blocks since written over but still
+         * held by readers.
+         */
+        struct ChunkResidencyUsage {
+            size_t blocks, snapshots, instances, navmeshes;
+
+            size_t total() const { return blocks + snapshots + instances + navmeshes; }
+        };
+
+        /**
+         * @brief What a chunk has given up to save memory, as a mask.
+         */
+        enum class ChunkDehydration : ui8 {
+            NONE      = 0x0,
+            NAVMESH   = 0x1,
+            INSTANCES = 0x2,
+            BLOCKS    = 0x4,
+            ALL       = 0x7
+        };
+
+        /**
+         * @brief Keeps the memory held by the chunks of a grid within a
+         * budget, by dehydrating those least recently needed.
+         *
+         * A chunk is needed whenever it is touched, and on each update by
+         * being within the active distance of a focus point. While the
+         * chunks of the grid hold more than the budget, chunks not needed
+         * in this update are dehydrated, least recently needed first, one
+         * step at a time: first each gives up its navmesh, then its
+         * instance data, and only then are its blocks compressed. Needing
+         * a dehydrated chunk rehydrates it, decompressing its blocks and
+         * requesting it be meshed and navmeshed again as needed.
+         *
+         * The grid touches chunks as they are read and written, see
+         * ChunkGrid::set_residency_manager, so a chunk is rehydrated once
+         * something needs it again.
+         *
+         * NOTE: Only the thread owning the chunk grid may use the manager,
+         *       bar touch which may be called from any thread.
+         */
+        class ChunkResidencyManager {
+        public:
+            ChunkResidencyManager();
+
+            ~ChunkResidencyManager() { /* Empty. */
+            }
+
+            /**
+             * @brief Initialises the manager.
+             *
+             * @param chunk_grid The grid whose chunks to manage.
+             * @param budget The number of bytes chunks may hold before
+             * being dehydrated.
+             * @param active_distance The distance in chunks from a focus
+             * point along every axis within which chunks are needed.
+             * @param max_dehydrations The most dehydration steps to take
+             * in one update.
+             */
+            void init(
+                hmem::WeakHandle<ChunkGrid> chunk_grid,
+                size_t                      budget,
+                ui32                        active_distance  = 2,
+                ui32                        max_dehydrations = 64
+            );
+            /**
+             * @brief Disposes of the manager, leaving chunks as they are.
+             */
+            void dispose();
+
+            /**
+             * @brief Sets the points about which chunks are needed.
+             *
+             * @param focus_points The positions of the focus points.
+             * @param focus_point_count The number of focus points.
+             */
+            void set_focus_points(
+                const ChunkGridPosition* focus_points, ui32 focus_point_count
+            );
+
+            void set_budget(size_t budget) { m_budget = budget; }
+
+            size_t budget() const { return m_budget; }
+
+            /**
+             * @brief Marks the chunk at the given position as needed,
+             * rehydrating what of it is needed if that was dehydrated. This
+             * takes effect on the next update. Safe to call from any thread.
+             *
+             * @param chunk_position The position of the chunk.
+             * @param needs The mask of what of the chunk is needed, e.g.
+             * only its blocks when read by a neighbour's mesh task.
+             */
+            void touch(
+                ChunkGridPosition chunk_position,
+                ChunkDehydration  needs = ChunkDehydration::ALL
+            );
+
+            /**
+             * @brief Brings the memory held by chunks in line with the
+             * budget, as far as this update's share of work allows.
+             */
+            void update();
+
+            /**
+             * @brief The memory held by chunks as of the last update.
+             */
+            ChunkResidencyUsage usage() const { return m_usage; }
+
+            /**
+             * @brief The number of chunks that have given up anything.
+             */
+            size_t dehydrated_count() const;
+        protected:
+            struct ChunkResidency {
+                ui64 last_needed, last_seen;
+                ui8  dehydration;
+            };
+
+            /**
+             * @brief Marks the given chunk as needed in this update,
+             * rehydrating what of it is needed if that was dehydrated.
+             */
+            void need(
+                hmem::Handle<ChunkGrid> chunk_grid,
+                hmem::Handle<Chunk>     chunk,
+                ChunkResidency&         residency,
+                ui8                     needs = static_cast<ui8>(ChunkDehydration::ALL)
+            );
+
+            /**
+             * @brief Marks each chunk touched since the last update as
+             * needed.
+             */
+            void need_touched(hmem::Handle<ChunkGrid> chunk_grid);
+
+            /**
+             * @brief Takes one step of dehydration of the given chunk.
+             *
+             * @return The number of bytes freed, 0 if none could be.
+             */
+            size_t dehydrate(
+                hmem::Handle<Chunk> chunk,
+                ChunkResidency&     residency,
+                ChunkDehydration    step
+            );
+
+            /**
+             * @brief Records each chunk of the grid, forgetting those since
+             * unloaded, and totals the memory they hold.
+             */
+            void update_usage(hmem::Handle<ChunkGrid> chunk_grid);
+
+            hmem::WeakHandle<ChunkGrid> m_chunk_grid;
+
+            size_t m_budget;
+            ui32   m_active_distance, m_max_dehydrations;
+            ui64   m_tick;
+
+            std::vector<ChunkGridPosition> m_focus_points;
+
+            ChunkResidencyUsage                         m_usage;
+            std::unordered_map<ChunkID, ChunkResidency> m_residencies;
+
+            std::vector<std::pair<ui64, ChunkID>> m_candidates;
+
+            std::mutex                                     m_touched_mutex;
+            std::vector<std::pair<ChunkGridPosition, ui8>> m_touched, m_touched_buffer;
+        };
+    }  // namespace voxel
+}  // namespace hemlock
+namespace hvox = hemlock::voxel;
+
+#endif  // __hemlock_voxel_chunk_residency_h
@@ -0,0 +1,153 @@
+#ifndef __hemlock_voxel_chunk_scheduler_h
+#define __hemlock_voxel_chunk_scheduler_h
+
+#include "voxel/coordinate_system.h"
+#include "voxel/task.hpp"
+
+namespace hemlock {
+    namespace voxel {
+        /**
+         * @brief Holds chunk tasks back from a thread pool, handing them to it
+         * nearest first so that the chunks about the focus points of a grid,
+         * e.g. the camera, are loaded and meshed before those far from them.
+         *
+         * A task's priority is the squared distance in chunks from its chunk
+         * to the nearest focus point, ties being broken by the kind of task
+         * such that a chunk is generated before it or its neighbours at the
+         * same distance are meshed. Only enough tasks to keep the thread pool
+         * busy are handed over at each dispatch, so that priorities can still
+         * change for the rest. When the focus points move, the priorities of
+         * held tasks are recalculated once at the next dispatch. Cancelled
+         * tasks are dropped rather than handed over.
+         *
+         * NOTE: Only the owning thread may dispatch, set focus points or use
+         * schedule. Any thread may use threadsafe_schedule.
+         */
+        class ChunkTaskScheduler {
+        public:
+            ChunkTaskScheduler();
+
+            ~ChunkTaskScheduler() { /* Empty. */
+            }
+
+            /**
+             * @brief Initialises the scheduler.
+             *
+             * @param thread_pool The thread pool to hand tasks to.
+             * @param queue_depth The number of tasks to keep queued in the
+             * thread pool, held tasks are handed over only while it has
+             * fewer than this queued.
+             */
+            void init(
+                thread::ThreadPool<ChunkTaskContext>* thread_pool, ui32 queue_depth
+            );
+            /**
+             * @brief Disposes of the scheduler, deleting all held tasks.
+             */
+            void dispose();
+
+            /**
+             * @brief Sets the points about which chunk tasks are prioritised.
+             * With no focus points, tasks are handed over by kind and then
+             * in the order they were scheduled.
+             *
+             * @param focus_points The positions of the focus points.
+             * @param focus_point_count The number of focus points.
+             */
+            void set_focus_points(
+                const ChunkGridPosition* focus_points, ui32 focus_point_count
+            );
+
+            /**
+             * @brief Schedules a task. The scheduler takes ownership of the
+             * task, which is deleted once run.
+             *
+             * NOTE: This should only ever be called from the thread owning
+             * the scheduler.
+             *
+             * @param task The task to schedule.
+             * @param position The position of the chunk the task is for.
+             * @param kind The kind of the task.
+             */
+            void
+            schedule(ChunkTask* task, ChunkGridPosition position, ChunkTaskKind kind);
+            /**
+             * @brief Schedules a task. The scheduler takes ownership of the
+             * task, which is deleted once run.
+             *
+             * NOTE: This can be called from any thread, tasks scheduled with
+             * it are prioritised at the next dispatch.
+             *
+             * @param task The task to schedule.
+             * @param position The position of the chunk the task is for.
+             * @param kind The kind of the task.
+             */
+            void threadsafe_schedule(
+                ChunkTask* task, ChunkGridPosition position, ChunkTaskKind kind
+            );
+
+            /**
+             * @brief Hands the highest priority tasks to the thread pool,
+             * enough to bring it up to the queue depth.
+             */
+            void dispatch();
+
+            /**
+             * @brief The number of tasks held back from the thread pool,
+             * not counting those scheduled from other threads since the
+             * last dispatch.
+             */
+            size_t pending_count() const { return m_tasks.size(); }
+        protected:
+            struct ScheduledTask {
+                ui64              priority;
+                ui64              order;
+                ChunkTask*        task;
+                ChunkGridPosition position;
+                ChunkTaskKind     kind;
+            };
+
+            /**
+             * @brief Orders tasks such that the heap holds the lowest
+             * priority value, i.e. the most urgent task, at its front.
+             */
+            struct LessUrgent {
+                bool
+                operator()(const ScheduledTask& lhs, const ScheduledTask& rhs) const {
+                    if (lhs.priority != rhs.priority)
+                        return lhs.priority > rhs.priority;
+                    return lhs.order > rhs.order;
+                }
+            };
+
+            /**
+             * @brief Calculates the priority of a task for a chunk at the
+             * given position, lower values being more urgent.
+             */
+            ui64 priority_of(ChunkGridPosition position, ChunkTaskKind kind) const;
+
+            /**
+             * @brief Moves tasks scheduled from other threads onto the heap,
+             * and recalculates every priority if the focus points moved.
+             */
+            void update_heap();
+
+            thread::ThreadPool<ChunkTaskContext>* m_thread_pool;
+            ui32                                  m_queue_depth;
+
+            std::vector<ChunkGridPosition> m_focus_points;
+            bool                           m_focus_changed;
+
+            ui64                       m_next_order;
+            std::vector<ScheduledTask> m_tasks;
+
+            std::mutex                 m_incoming_tasks_mutex;
+            std::vector<ScheduledTask> m_incoming_tasks;
+
+            std::vector<thread::HeldTask<ChunkTaskContext>> m_dispatch_buffer;
+        };
+    }  // namespace voxel
+}  // namespace hemlock
+namespace hvox = hemlock::voxel;
+
+#endif  // __hemlock_voxel_chunk_scheduler_h
@@ -2,6 +2,8 @@
 #define __hemlock_voxel_chunk_setter_hpp
 
 #include "voxel/block.hpp"
+#include "voxel/block_layout.hpp"
+#include "voxel/chunk/constants.hpp"
 #include "voxel/coordinate_system.h"
 
 namespace hemlock {
@@ -52,7 +54,8 @@ namespace hemlock {
          *
          * @param chunk The chunk in which to set the block.
          * @param start The starting position of the range to set blocks for.
-         * @param end The end position of the range to set blocks for.
+         * @param end The end position of the range to set blocks for, one
+         * past the last position set along each axis.
          * @param blocks The blocks to set.
          *
          * @return True if the blocks were set, false otherwise.
@@ -6,6 +6,23 @@ void hvox::set_per_block_data(
     hvox::BlockChunkPosition end,
     DataType                 data
 ) {
+    /*
+     * Under bit-packed layouts only the whole chunk is certain to be contiguous
+     * in memory, so otherwise we visit the cuboid in layout order.
+     */
+    if constexpr (BLOCK_LAYOUT != BlockLayout::LINEAR) {
+        if (start == hvox::BlockChunkPosition{ 0 }
+            && end == hvox::BlockChunkPosition{ CHUNK_LENGTH - 1 })
+        {
+            std::fill_n(buffer, CHUNK_VOLUME, data);
+        } else {
+            for_each_block_in(start, end, [&](BlockIndex index, BlockChunkPosition) {
+                buffer[index] = data;
+            });
+        }
+        return;
+    }
+
     /*
      * If we span the whole chunk, we just fill the whole buffer.
      */
@@ -53,11 +70,29 @@ void hvox::set_per_block_data(
     hvox::BlockChunkPosition end,
     DataType*                data
 ) {
+    /*
+     * Under bit-packed layouts the data buffer, being in x, then y, then z
+     * order, doesn't match the layout, so we copy block by block.
+     */
+    if constexpr (BLOCK_LAYOUT != BlockLayout::LINEAR) {
+        const BlockChunkPosition dims = end - start;
+        for_each_block_in(
+            start,
+            end - BlockChunkPosition{ 1 },
+            [&](BlockIndex index, BlockChunkPosition position) {
+                const BlockChunkPosition offset = position - start;
+                buffer[index]
+                    = data[offset.x + dims.x * (offset.y + dims.y * offset.z)];
+            }
+        );
+        return;
+    }
+
     /*
      * If we span the whole chunk, we just copy in the whole buffer.
      */
     if (start == BlockChunkPosition{ 0 } && end == BlockChunkPosition{ CHUNK_LENGTH }) {
-        std::memcpy(buffer, data, CHUNK_VOLUME);
+        std::copy_n(data, CHUNK_VOLUME, buffer);
         /*
          * If we span the XY plane, then we copy the whole cuboid as all
          * elements it touches are contiguous in memory.
@@ -66,7 +101,7 @@ void hvox::set_per_block_data(
     {
         auto batch_size = CHUNK_AREA * (end.z - start.z);
         auto start_idx  = block_index({ 0, 0, start.z });
-        std::memcpy(&(buffer[start_idx]), data, batch_size);
+        std::copy_n(data, batch_size, &(buffer[start_idx]));
         /*
          * If we span the X line, then we copy squares in XY plane one at a time.
          */
@@ -75,10 +110,10 @@ void hvox::set_per_block_data(
         for (auto z = start.z; z < end.z; ++z) {
             auto chunk_blocks_start_idx = block_index({ 0, start.y, z });
             auto new_blocks_start_idx   = batch_size * (z - start.z);
-            std::memcpy(
-                &(buffer[chunk_blocks_start_idx]),
+            std::copy_n(
                 &(data[new_blocks_start_idx]),
-                batch_size
+                batch_size,
+                &(buffer[chunk_blocks_start_idx])
             );
         }
         /*
@@ -93,10 +128,10 @@ void hvox::set_per_block_data(
                 auto new_blocks_start_idx
                     = batch_size * (y - start.y)
                       + batch_size * (end.y - start.y) * (z - start.z);
-                std::memcpy(
-                    &(buffer[chunk_blocks_start_idx]),
+                std::copy_n(
                     &(data[new_blocks_start_idx]),
-                    batch_size
+                    batch_size,
+                    &(buffer[chunk_blocks_start_idx])
                 );
             }
         }
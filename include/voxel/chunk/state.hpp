@@ -17,27 +17,223 @@ namespace hemlock {
             DEAD
         };
 
+        constexpr ui8 NEIGHBOUR_COUNT = 26;
+
+        struct NeighbourOffset {
+            i8 x, y, z;
+        };
+
+        /**
+         * @brief The offset in chunks of each neighbour held in
+         * Neighbours::all. The six face neighbours come first, in the order
+         * of ChunkFace, then the twelve edge neighbours and lastly the eight
+         * corner neighbours.
+         */
+        inline constexpr NeighbourOffset NEIGHBOUR_OFFSETS[NEIGHBOUR_COUNT] = {
+            // Faces.
+            { -1, 0, 0 },
+            { 1, 0, 0 },
+            { 0, 1, 0 },
+            { 0, -1, 0 },
+            { 0, 0, 1 },
+            { 0, 0, -1 },
+            // Edges.
+            { -1, 1, 0 },
+            { 1, 1, 0 },
+            { 0, 1, 1 },
+            { 0, 1, -1 },
+            { -1, -1, 0 },
+            { 1, -1, 0 },
+            { 0, -1, 1 },
+            { 0, -1, -1 },
+            { -1, 0, 1 },
+            { 1, 0, 1 },
+            { -1, 0, -1 },
+            { 1, 0, -1 },
+            // Corners.
+            { -1, 1, 1 },
+            { 1, 1, 1 },
+            { -1, 1, -1 },
+            { 1, 1, -1 },
+            { -1, -1, 1 },
+            { 1, -1, 1 },
+            { -1, -1, -1 },
+            { 1, -1, -1 }
+        };
+
+        /**
+         * @brief Gets the index into Neighbours::all of the neighbour at the
+         * given offset in chunks, each component of which must be one of
+         * -1, 0 or 1 and not all of which may be 0.
+         */
+        constexpr ui8 neighbour_index(i32 dx, i32 dy, i32 dz) {
+            for (ui8 index = 0; index < NEIGHBOUR_COUNT; ++index) {
+                const NeighbourOffset& offset = NEIGHBOUR_OFFSETS[index];
+                if (offset.x == dx && offset.y == dy && offset.z == dz) return index;
+            }
+            return NEIGHBOUR_COUNT;
+        }
+
+        namespace impl {
+            constexpr auto make_opposite_neighbours() {
+                std::array<ui8, NEIGHBOUR_COUNT> opposites{};
+                for (ui8 index = 0; index < NEIGHBOUR_COUNT; ++index) {
+                    const NeighbourOffset& offset = NEIGHBOUR_OFFSETS[index];
+                    opposites[index]
+                        = neighbour_index(-offset.x, -offset.y, -offset.z);
+                }
+                return opposites;
+            }
+
+            inline constexpr std::array<ui8, NEIGHBOUR_COUNT> OPPOSITE_NEIGHBOURS
+                = make_opposite_neighbours();
+        }  // namespace impl
+
+        /**
+         * @brief Gets the index into Neighbours::all of the neighbour on the
+         * opposite side of a chunk to the neighbour of the given index. That
+         * is, if B is neighbour N of A, then A is neighbour opposite(N) of B.
+         */
+        constexpr ui8 opposite_neighbour(ui8 index) {
+            return impl::OPPOSITE_NEIGHBOURS[index];
+        }
+
+        /**
+         * @brief The mask of the face neighbours among a set of neighbour
+         * bits, where bit N stands for neighbour N of Neighbours::all.
+         */
+        constexpr ui32 FACE_NEIGHBOURS_MASK = 0x3F;
+        /**
+         * @brief The mask of all neighbours among a set of neighbour bits.
+         */
+        constexpr ui32 ALL_NEIGHBOURS_MASK = (1 << NEIGHBOUR_COUNT) - 1;
+
         union Neighbours {
             Neighbours() : all{} { /* Empty. */
             }
 
-            Neighbours(const Neighbours& rhs) {
-                for (size_t i = 0; i < 8; ++i) all[i] = rhs.all[i];
+            Neighbours(const Neighbours& rhs) : all{} {
+                for (size_t i = 0; i < NEIGHBOUR_COUNT; ++i) all[i] = rhs.all[i];
             }
 
-            ~Neighbours() { /* Empty. */
-            }
+            ~Neighbours() { std::destroy(std::begin(all), std::end(all)); }
 
             Neighbours& operator=(const Neighbours& rhs) {
-                for (size_t i = 0; i < 8; ++i) all[i] = rhs.all[i];
+                for (size_t i = 0; i < NEIGHBOUR_COUNT; ++i) all[i] = rhs.all[i];
                 return *this;
             }
 
+            /**
+             * @brief Gets the neighbour at the given offset in chunks, see
+             * neighbour_index.
+             */
+            hmem::WeakHandle<Chunk>& at(i32 dx, i32 dy, i32 dz) {
+                return all[neighbour_index(dx, dy, dz)];
+            }
+
             struct {
                 hmem::WeakHandle<Chunk> left, right, top, bottom, front, back;
             } one;
 
-            hmem::WeakHandle<Chunk> all[8];
+            hmem::WeakHandle<Chunk> all[NEIGHBOUR_COUNT];
+        };
+
+        /**
+         * @brief Tracks which of a chunk's neighbours are linked to it and
+         * which of them have reached some chunk state, such that whether all
+         * of a set of neighbours are ready can be checked with a single
+         * atomic load.
+         *
+         * Bit N of each mask stands for neighbour N of Neighbours::all. The
+         * linked mask is held in the low 32 bits and the reached mask in the
+         * high 32 bits of one word. A neighbour may be marked as having
+         * reached the state before it is linked, as the two happen on
+         * different threads, and so linking never clears its reached bit.
+         */
+        class NeighbourStates {
+        public:
+            NeighbourStates() : m_bits(0) { /* Empty. */
+            }
+
+            /**
+             * @brief Marks the given neighbour as linked.
+             *
+             * @param index The index of the neighbour.
+             * @param reached Whether the neighbour has already reached the
+             * state.
+             */
+            void link(ui8 index, bool reached) {
+                ui64 bits = ui64{ 1 } << index;
+                if (reached) bits |= ui64{ 1 } << (32 + index);
+                m_bits.fetch_or(bits, std::memory_order_acq_rel);
+            }
+
+            /**
+             * @brief Marks the given neighbour as unlinked, forgetting whether
+             * it had reached the state.
+             *
+             * @param index The index of the neighbour.
+             */
+            void unlink(ui8 index) {
+                m_bits.fetch_and(
+                    ~((ui64{ 1 } << index) | (ui64{ 1 } << (32 + index))),
+                    std::memory_order_acq_rel
+                );
+            }
+
+            /**
+             * @brief Marks the given neighbour as having reached the state.
+             *
+             * @param index The index of the neighbour.
+             */
+            void set_reached(ui8 index) {
+                m_bits.fetch_or(ui64{ 1 } << (32 + index), std::memory_order_acq_rel);
+            }
+
+            /**
+             * @brief Forgets all neighbours.
+             */
+            void clear() { m_bits.store(0, std::memory_order_release); }
+
+            /**
+             * @brief The mask of linked neighbours.
+             */
+            ui32 linked() const {
+                return static_cast<ui32>(m_bits.load(std::memory_order_acquire));
+            }
+
+            /**
+             * @brief The mask of neighbours that have reached the state.
+             */
+            ui32 reached() const {
+                return static_cast<ui32>(m_bits.load(std::memory_order_acquire) >> 32);
+            }
+
+            /**
+             * @brief Whether every neighbour of the given mask is linked and
+             * has reached the state.
+             *
+             * @param mask The neighbours to check.
+             */
+            bool all_reached(ui32 mask = ALL_NEIGHBOURS_MASK) const {
+                const ui64 bits = m_bits.load(std::memory_order_acquire);
+                return (static_cast<ui32>(bits) & static_cast<ui32>(bits >> 32) & mask)
+                       == mask;
+            }
+
+            /**
+             * @brief Whether every linked neighbour of the given mask has
+             * reached the state, neighbours not yet loaded being ignored.
+             *
+             * @param mask The neighbours to check.
+             */
+            bool all_linked_reached(ui32 mask = ALL_NEIGHBOURS_MASK) const {
+                const ui64 bits   = m_bits.load(std::memory_order_acquire);
+                const ui32 linked = static_cast<ui32>(bits) & mask;
+                return (static_cast<ui32>(bits >> 32) & linked) == linked;
+            }
+        protected:
+            std::atomic<ui64> m_bits;
         };
     }  // namespace voxel
 }  // namespace hemlock
@@ -0,0 +1,134 @@
+#ifndef __hemlock_voxel_chunk_streamer_h
+#define __hemlock_voxel_chunk_streamer_h
+
+#include "voxel/coordinate_system.h"
+
+namespace hemlock {
+    namespace voxel {
+        class ChunkGrid;
+
+        /**
+         * @brief The most work of each kind a chunk streamer may do in one
+         * update.
+         */
+        struct ChunkStreamingBudget {
+            ui32 preloads, loads, unloads;
+        };
+
+        /**
+         * @brief Loads and unloads the chunks of a grid about one or more
+         * focus points, e.g. the player, such that every chunk within the
+         * grid's render distance of any focus point is loaded.
+         *
+         * Chunks are loaded once within half the render distance of a focus
+         * point along every axis, nearest first, but not unloaded until
+         * further than that plus the hysteresis from every focus point, so
+         * that moving back and forth across a chunk boundary doesn't load
+         * and unload the same chunks over and over. The preloads, loads and
+         * unloads done in any one update are limited by a budget, with the
+         * rest carried over to later updates, so that frame times stay
+         * predictable even when the focus points move fast.
+         *
+         * NOTE: Only the thread owning the chunk grid may use the streamer.
+         */
+        class ChunkStreamer {
+        public:
+            ChunkStreamer();
+
+            ~ChunkStreamer() { /* Empty. */
+            }
+
+            /**
+             * @brief Initialises the streamer.
+             *
+             * @param chunk_grid The grid to stream chunks of.
+             * @param budget The most work of each kind to do per update.
+             * @param hysteresis The number of chunks beyond the load
+             * distance a chunk must be before it is unloaded.
+             */
+            void init(
+                hmem::WeakHandle<ChunkGrid> chunk_grid,
+                ChunkStreamingBudget        budget     = { 256, 128, 128 },
+                ui32                        hysteresis = 1
+            );
+            /**
+             * @brief Disposes of the streamer, leaving any chunks it loaded
+             * in the grid.
+             */
+            void dispose();
+
+            /**
+             * @brief Sets the points about which chunks are streamed, these
+             * are also given to the grid to prioritise chunk tasks by.
+             *
+             * @param focus_points The positions of the focus points.
+             * @param focus_point_count The number of focus points.
+             */
+            void set_focus_points(
+                const ChunkGridPosition* focus_points, ui32 focus_point_count
+            );
+
+            void set_budget(ChunkStreamingBudget budget) { m_budget = budget; }
+
+            ChunkStreamingBudget budget() const { return m_budget; }
+
+            void set_hysteresis(ui32 hysteresis) {
+                m_hysteresis    = hysteresis;
+                m_focus_changed = true;
+            }
+
+            ui32 hysteresis() const { return m_hysteresis; }
+
+            /**
+             * @brief Does this update's share of the work needed to bring
+             * the loaded chunks in line with the focus points.
+             */
+            void update();
+
+            /**
+             * @brief The number of chunks waiting to be preloaded, loaded or
+             * unloaded.
+             */
+            size_t pending_count() const {
+                return m_preload_queue.size() + m_load_queue.size()
+                       + m_unload_queue.size();
+            }
+        protected:
+            /**
+             * @brief Gets the distance in chunks along the axis on which it
+             * is greatest from the given position to the nearest focus point.
+             */
+            i64 distance_to_focus(ChunkGridPosition position) const;
+
+            /**
+             * @brief Works out which chunks need loading and which
+             * unloading, for the focus points and render distance now set.
+             */
+            void update_queues();
+
+            hmem::WeakHandle<ChunkGrid> m_chunk_grid;
+
+            ChunkStreamingBudget m_budget;
+            ui32                 m_hysteresis;
+
+            std::vector<ChunkGridPosition> m_focus_points;
+            bool                           m_focus_changed;
+            ui32                           m_render_distance;
+
+            // Chunks loaded, or waiting to be loaded, by the streamer.
+            std::unordered_set<ChunkID> m_streamed_chunks;
+            // Chunks preloaded but never loaded that are waiting to be
+            // unloaded, which must be queued for loading once more should
+            // they come back into range first.
+            std::unordered_set<ChunkID> m_unloading_preloads;
+
+            std::deque<ChunkGridPosition>  m_preload_queue, m_load_queue;
+            std::vector<ChunkGridPosition> m_unload_queue;
+
+            std::vector<ChunkGridPosition> m_load_buffer;
+        };
+    }  // namespace voxel
+}  // namespace hemlock
+namespace hvox = hemlock::voxel;
+
+#endif  // __hemlock_voxel_chunk_streamer_h
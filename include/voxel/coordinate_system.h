@@ -149,6 +149,15 @@ namespace hemlock {
          * @return ChunkGridPosition The grid position of the enclosing chunk.
          */
         ChunkGridPosition chunk_grid_position(BlockWorldPosition block_world_position);
+
+        /**
+         * @brief Gets the position of the column a chunk is in, the column
+         * being at the chunk's x and z coordinates in grid space.
+         *
+         * @param chunk_grid_position The grid position of the chunk.
+         * @return ColumnWorldPosition The position of the enclosing column.
+         */
+        ColumnWorldPosition column_position(ChunkGridPosition chunk_grid_position);
     }  // namespace voxel
 }  // namespace hemlock
 namespace hvox = hemlock::voxel;
@@ -1,56 +1,180 @@
 #ifndef __hemlock_voxel_face_check_hpp
 #define __hemlock_voxel_face_check_hpp
 
+#include "voxel/block_layout.hpp"
 #include "voxel/chunk/constants.hpp"
 
 namespace hemlock {
     namespace voxel {
+        namespace impl {
+            // NOTE(Matthew): Bit-packed layouts store each coordinate in its own
+            //                set of index bits, so we can step along an axis by
+            //                incrementing or decrementing just those bits.
+
+            template <ui32 Axis>
+            inline hvox::BlockIndex step_up(hvox::BlockIndex index) {
+                constexpr hvox::BlockIndex mask = block_index_axis_mask<Axis>();
+                return (((index | ~mask) + 1) & mask) | (index & ~mask);
+            }
+
+            template <ui32 Axis>
+            inline hvox::BlockIndex step_down(hvox::BlockIndex index) {
+                constexpr hvox::BlockIndex mask = block_index_axis_mask<Axis>();
+                return (((index & mask) - 1) & mask) | (index & ~mask);
+            }
+        }  // namespace impl
+
         static inline bool is_at_left_face(hvox::BlockIndex index) {
-            return (index % CHUNK_LENGTH) == 0;
+            if constexpr (BLOCK_LAYOUT == BlockLayout::LINEAR) {
+                return (index % CHUNK_LENGTH) == 0;
+            } else {
+                return (index & block_index_axis_mask<0>()) == 0;
+            }
         }
 
         static inline bool is_at_right_face(hvox::BlockIndex index) {
-            return ((index + 1) % CHUNK_LENGTH) == 0;
+            if constexpr (BLOCK_LAYOUT == BlockLayout::LINEAR) {
+                return ((index + 1) % CHUNK_LENGTH) == 0;
+            } else {
+                constexpr hvox::BlockIndex mask = block_index_axis_mask<0>();
+                return (index & mask) == mask;
+            }
         }
 
         static inline bool is_at_bottom_face(hvox::BlockIndex index) {
-            return (index % (CHUNK_AREA)) < CHUNK_LENGTH;
+            if constexpr (BLOCK_LAYOUT == BlockLayout::LINEAR) {
+                return (index % (CHUNK_AREA)) < CHUNK_LENGTH;
+            } else {
+                return (index & block_index_axis_mask<1>()) == 0;
+            }
         }
 
         static inline bool is_at_top_face(hvox::BlockIndex index) {
-            return (index % (CHUNK_AREA)) >= (CHUNK_LENGTH * (CHUNK_LENGTH - 1));
+            if constexpr (BLOCK_LAYOUT == BlockLayout::LINEAR) {
+                return (index % (CHUNK_AREA)) >= (CHUNK_LENGTH * (CHUNK_LENGTH - 1));
+            } else {
+                constexpr hvox::BlockIndex mask = block_index_axis_mask<1>();
+                return (index & mask) == mask;
+            }
         }
 
         static inline bool is_at_front_face(hvox::BlockIndex index) {
-            return index < (CHUNK_AREA);
+            if constexpr (BLOCK_LAYOUT == BlockLayout::LINEAR) {
+                return index < (CHUNK_AREA);
+            } else {
+                return (index & block_index_axis_mask<2>()) == 0;
+            }
         }
 
         static inline bool is_at_back_face(hvox::BlockIndex index) {
-            return index >= (CHUNK_AREA * (CHUNK_LENGTH - 1));
+            if constexpr (BLOCK_LAYOUT == BlockLayout::LINEAR) {
+                return index >= (CHUNK_AREA * (CHUNK_LENGTH - 1));
+            } else {
+                constexpr hvox::BlockIndex mask = block_index_axis_mask<2>();
+                return (index & mask) == mask;
+            }
         }
 
         static inline hvox::BlockIndex index_at_right_face(hvox::BlockIndex index) {
-            return index + CHUNK_LENGTH - 1;
+            if constexpr (BLOCK_LAYOUT == BlockLayout::LINEAR) {
+                return index + CHUNK_LENGTH - 1;
+            } else {
+                return index | block_index_axis_mask<0>();
+            }
         }
 
         static inline hvox::BlockIndex index_at_left_face(hvox::BlockIndex index) {
-            return index - CHUNK_LENGTH + 1;
+            if constexpr (BLOCK_LAYOUT == BlockLayout::LINEAR) {
+                return index - CHUNK_LENGTH + 1;
+            } else {
+                return index & ~block_index_axis_mask<0>();
+            }
         }
 
         static inline hvox::BlockIndex index_at_top_face(hvox::BlockIndex index) {
-            return index + (CHUNK_LENGTH * (CHUNK_LENGTH - 1));
+            if constexpr (BLOCK_LAYOUT == BlockLayout::LINEAR) {
+                return index + (CHUNK_LENGTH * (CHUNK_LENGTH - 1));
+            } else {
+                return index | block_index_axis_mask<1>();
+            }
         }
 
         static inline hvox::BlockIndex index_at_bottom_face(hvox::BlockIndex index) {
-            return index - (CHUNK_LENGTH * (CHUNK_LENGTH - 1));
+            if constexpr (BLOCK_LAYOUT == BlockLayout::LINEAR) {
+                return index - (CHUNK_LENGTH * (CHUNK_LENGTH - 1));
+            } else {
+                return index & ~block_index_axis_mask<1>();
+            }
         }
 
         static inline hvox::BlockIndex index_at_front_face(hvox::BlockIndex index) {
-            return index - (CHUNK_AREA * (CHUNK_LENGTH - 1));
+            if constexpr (BLOCK_LAYOUT == BlockLayout::LINEAR) {
+                return index - (CHUNK_AREA * (CHUNK_LENGTH - 1));
+            } else {
+                return index & ~block_index_axis_mask<2>();
+            }
         }
 
         static inline hvox::BlockIndex index_at_back_face(hvox::BlockIndex index) {
-            return index + (CHUNK_AREA * (CHUNK_LENGTH - 1));
+            if constexpr (BLOCK_LAYOUT == BlockLayout::LINEAR) {
+                return index + (CHUNK_AREA * (CHUNK_LENGTH - 1));
+            } else {
+                return index | block_index_axis_mask<2>();
+            }
+        }
+
+        /**
+         * The following give the index of the neighbouring block in the named
+         * direction, and must not be called for blocks on the corresponding
+         * face of the chunk.
+         */
+
+        static inline hvox::BlockIndex index_left_of(hvox::BlockIndex index) {
+            if constexpr (BLOCK_LAYOUT == BlockLayout::LINEAR) {
+                return index - 1;
+            } else {
+                return impl::step_down<0>(index);
+            }
+        }
+
+        static inline hvox::BlockIndex index_right_of(hvox::BlockIndex index) {
+            if constexpr (BLOCK_LAYOUT == BlockLayout::LINEAR) {
+                return index + 1;
+            } else {
+                return impl::step_up<0>(index);
+            }
+        }
+
+        static inline hvox::BlockIndex index_below(hvox::BlockIndex index) {
+            if constexpr (BLOCK_LAYOUT == BlockLayout::LINEAR) {
+                return index - CHUNK_LENGTH;
+            } else {
+                return impl::step_down<1>(index);
+            }
+        }
+
+        static inline hvox::BlockIndex index_above(hvox::BlockIndex index) {
+            if constexpr (BLOCK_LAYOUT == BlockLayout::LINEAR) {
+                return index + CHUNK_LENGTH;
+            } else {
+                return impl::step_up<1>(index);
+            }
+        }
+
+        static inline hvox::BlockIndex index_in_front_of(hvox::BlockIndex index) {
+            if constexpr (BLOCK_LAYOUT == BlockLayout::LINEAR) {
+                return index - (CHUNK_AREA);
+            } else {
+                return impl::step_down<2>(index);
+            }
+        }
+
+        static inline hvox::BlockIndex index_behind(hvox::BlockIndex index) {
+            if constexpr (BLOCK_LAYOUT == BlockLayout::LINEAR) {
+                return index + (CHUNK_AREA);
+            } else {
+                return impl::step_up<2>(index);
+            }
         }
     }  // namespace voxel
 }  // namespace hemlock
@@ -0,0 +1,156 @@
+#ifndef __hemlock_voxel_generation_column_cache_h
+#define __hemlock_voxel_generation_column_cache_h
+
+#include "voxel/coordinate_system.h"
+
+namespace hemlock {
+    namespace voxel {
+        /**
+         * @brief Holds the products of generation passes that are the same
+         * for every chunk of a column, e.g. a heightmap or biome map, such
+         * that each is computed once for the column rather than once for
+         * each of its chunks. Each loaded chunk holds the data of its
+         * column, see Chunk::column_data.
+         *
+         * Products are computed by whichever thread first asks for them,
+         * any other thread asking meanwhile waiting until they are. Once
+         * computed, a product is kept until the column is unloaded.
+         */
+        class ColumnGenerationData {
+        public:
+            ColumnGenerationData(ColumnWorldPosition column_position) :
+                position(column_position) { /* Empty. */
+            }
+
+            /**
+             * @brief Gets the product of the given type for this column,
+             * computing it if this is the first time it is asked for. Safe
+             * to call from any thread.
+             *
+             * NOTE: A pass must not ask for its own product while computing
+             *       it, it would wait on itself.
+             *
+             * @tparam ProductType The type of product, each column holding
+             * at most one product of each type.
+             * @param compute Called with a default constructed product to
+             * fill in, should it not yet be computed. Should it throw, the
+             * product is left uncomputed, for the next thread asking for
+             * it to compute, and the exception is rethrown.
+             * @return The product, valid for as long as this data is held.
+             */
+            template <typename ProductType, typename Compute>
+                requires std::is_default_constructible_v<ProductType>
+                         && std::invocable<Compute, ProductType&>
+            const ProductType& product(Compute compute) {
+                const std::type_index type(typeid(ProductType));
+
+                std::unique_lock<std::mutex> lock(m_products_mutex);
+
+                // Another thread got here first, and so computes the product
+                // if it has not already. Should it fail to, the product is
+                // no longer held and we try computing it ourselves.
+                while (true) {
+                    auto [it, inserted] = m_products.try_emplace(type);
+                    if (inserted) break;
+
+                    if (it->second != nullptr)
+                        return *static_cast<const ProductType*>(it->second.get());
+
+                    m_product_computed.wait(lock);
+                }
+
+                lock.unlock();
+
+                hmem::Handle<ProductType> product;
+                try {
+                    product = hmem::make_handle<ProductType>();
+                    compute(*product);
+                } catch (...) {
+                    // Left in place, the empty product would have every other
+                    // thread asking for it wait forever.
+                    lock.lock();
+                    m_products.erase(type);
+                    lock.unlock();
+
+                    m_product_computed.notify_all();
+
+                    throw;
+                }
+
+                lock.lock();
+                m_products[type] = product;
+                lock.unlock();
+
+                m_product_computed.notify_all();
+
+                return *product;
+            }
+
+            const ColumnWorldPosition position;
+        protected:
+            std::mutex                                              m_products_mutex;
+            std::condition_variable                                 m_product_computed;
+            std::unordered_map<std::type_index, hmem::Handle<void>> m_products;
+        };
+
+        /**
+         * @brief Keeps the generation data of each column with chunks held
+         * by a chunk grid, counting the chunks of each column such that its
+         * data is dropped once none of its chunks is held. Chunks, and the
+         * tasks acting on them, keep the data of their column alive until
+         * they are released, but a column whose chunks are loaded anew has
+         * its products computed anew.
+         *
+         * NOTE: Only the thread owning the chunk grid may add or remove
+         *       chunks. Products may be computed from any thread through
+         *       the data of each column.
+         */
+        class ColumnGenerationCache {
+        public:
+            ColumnGenerationCache() { /* Empty. */
+            }
+
+            ~ColumnGenerationCache() { /* Empty. */
+            }
+
+            /**
+             * @brief Disposes of the cache, dropping its hold on the data
+             * of every column.
+             */
+            void dispose();
+
+            /**
+             * @brief Adds a chunk at the given position to its column.
+             *
+             * @param chunk_position The position of the chunk.
+             * @return hmem::Handle<ColumnGenerationData> The generation data
+             * of the chunk's column.
+             */
+            hmem::Handle<ColumnGenerationData>
+            add_chunk(ChunkGridPosition chunk_position);
+            /**
+             * @brief Removes the chunk at the given position from its
+             * column, dropping the column's data if no other chunk of it is
+             * held.
+             *
+             * @param chunk_position The position of the chunk.
+             */
+            void remove_chunk(ChunkGridPosition chunk_position);
+
+            /**
+             * @brief The number of columns with chunks held.
+             */
+            size_t column_count() const { return m_columns.size(); }
+        protected:
+            struct CachedColumn {
+                hmem::Handle<ColumnGenerationData> data;
+                ui32                               chunk_count;
+            };
+
+            std::unordered_map<ColumnID, CachedColumn> m_columns;
+        };
+    }  // namespace voxel
+}  // namespace hemlock
+namespace hvox = hemlock::voxel;
+
+#endif  // __hemlock_voxel_generation_column_cache_h
@@ -0,0 +1,74 @@
+#ifndef __hemlock_voxel_generation_column_task_hpp
+#define __hemlock_voxel_generation_column_task_hpp
+
+#include "voxel/generation/generator_task.hpp"
+
+namespace hemlock {
+    namespace voxel {
+        /**
+         * @brief Defines a struct whose operator() sets the blocks of a run
+         * of chunks stacked one on another in a column all at once, e.g.
+         * generating noise for the whole run in one go, using state kept on
+         * the thread it runs on, see ThreadedChunkGenerationStrategy.
+         *
+         * The chunks are given from the bottom up, the chunk at index i
+         * being i chunks above the given bottom position. Any chunk that is
+         * not to be generated, e.g. as it was loaded as saved, is nullptr.
+         */
+        template <typename StrategyCandidate>
+        concept ThreadedColumnGenerationStrategy = requires (
+            StrategyCandidate                        s,
+            ChunkGridPosition                        p,
+            const hmem::Handle<Chunk>*               c,
+            ui32                                     n,
+            typename StrategyCandidate::ThreadState& t
+        ) {
+                                                       {
+                                                           s.operator()(p, c, n, t)
+                                                           } -> std::same_as<void>;
+                                                   };
+
+        /**
+         * @brief Defines a struct whose operator() sets the blocks of a run
+         * of chunks stacked one on another in a column all at once, either
+         * on its own or with state kept on the thread it runs on, see
+         * ThreadedColumnGenerationStrategy.
+         */
+        template <typename StrategyCandidate>
+        concept ColumnGenerationStrategy
+            = ThreadedColumnGenerationStrategy<StrategyCandidate>
+              || requires (
+                  StrategyCandidate          s,
+                  ChunkGridPosition          p,
+                  const hmem::Handle<Chunk>* c,
+                  ui32                       n
+              ) {
+                     {
+                         s.operator()(p, c, n)
+                         } -> std::same_as<void>;
+                 };
+
+        /**
+         * @brief Loads or generates a run of chunks stacked one on another
+         * in a column, as ChunkGenerationTask does a single chunk, except
+         * that the chunks left to generate are generated together by the
+         * given strategy. Each chunk's generation is completed, and its
+         * on_load fired, once the whole run is generated. Chunks unloaded,
+         * or whose tasks were cancelled, before the task runs are skipped.
+         */
+        template <hvox::ColumnGenerationStrategy GenerationStrategy>
+        class ChunkColumnGenerationTask : public ChunkColumnTask {
+        public:
+            virtual ~ChunkColumnGenerationTask() { /* Empty. */
+            }
+
+            virtual void
+            execute(ChunkThreadState* state, ChunkTaskQueue* task_queue) override;
+        };
+    }  // namespace voxel
+}  // namespace hemlock
+namespace hvox = hemlock::voxel;
+
+#include "voxel/generation/column_task.inl"
+
+#endif  // __hemlock_voxel_generation_column_task_hpp
@@ -0,0 +1,53 @@
+template <hvox::ColumnGenerationStrategy GenerationStrategy>
+void hvox::ChunkColumnGenerationTask<
+    GenerationStrategy>::execute(ChunkThreadState* state, ChunkTaskQueue*) {
+    const ui32 chunk_count = static_cast<ui32>(m_chunks.size());
+
+    // The chunks whose generation this task has taken on, and of those the
+    // chunks left to generate.
+    std::vector<hmem::Handle<Chunk>> chunks(chunk_count);
+    std::vector<hmem::Handle<Chunk>> to_generate(chunk_count);
+    std::vector<std::vector<ui8>>    deltas(chunk_count);
+
+    bool any_to_generate = false;
+    for (ui32 i = 0; i < chunk_count; ++i) {
+        auto chunk = live_chunk(i);
+        if (chunk == nullptr) continue;
+
+        // A chunk cancelled and loaded anew since this task was built has
+        // a task of its own.
+        ChunkState pending_state = ChunkState::PENDING;
+        if (!chunk->generation.compare_exchange_strong(
+                pending_state, ChunkState::ACTIVE, std::memory_order_acq_rel
+            ))
+            continue;
+
+        if (begin_generation(chunk, m_chunk_grid, deltas[i])) {
+            to_generate[i]  = chunk;
+            any_to_generate = true;
+        }
+
+        chunks[i] = std::move(chunk);
+    }
+
+    if (any_to_generate) {
+        const GenerationStrategy generate{};
+
+        if constexpr (ThreadedColumnGenerationStrategy<GenerationStrategy>) {
+            using ThreadState = typename GenerationStrategy::ThreadState;
+
+            generate(
+                m_bottom,
+                to_generate.data(),
+                chunk_count,
+                state->context.template state<ThreadState>()
+            );
+        } else {
+            generate(m_bottom, to_generate.data(), chunk_count);
+        }
+    }
+
+    for (ui32 i = 0; i < chunk_count; ++i) {
+        if (chunks[i] != nullptr) end_generation(chunks[i], deltas[i]);
+    }
+}
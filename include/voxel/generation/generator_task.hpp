@@ -6,18 +6,76 @@
 namespace hemlock {
     namespace voxel {
         struct Chunk;
+        class ChunkGrid;
 
         /**
-         * @brief Defines a struct whose opeartor() sets the blocks of a chunk.
+         * @brief Defines a struct whose opeartor() sets the blocks of a chunk
+         * using state kept on the thread it runs on, e.g. a prebuilt noise
+         * node graph and scratch buffers. The state is of the struct's
+         * ThreadState type, which is default constructed once on each thread
+         * of the pool, see ChunkTaskContext::state.
+         */
+        template <typename StrategyCandidate>
+        concept ThreadedChunkGenerationStrategy = requires (
+            StrategyCandidate                        s,
+            hmem::Handle<Chunk>                      c,
+            typename StrategyCandidate::ThreadState& t
+        ) {
+                                                      {
+                                                          s.operator()(c, t)
+                                                          } -> std::same_as<void>;
+                                                  };
+
+        /**
+         * @brief Defines a struct whose opeartor() sets the blocks of a chunk,
+         * either on its own or with state kept on the thread it runs on.
+         * Passes whose products are the same for every chunk of a column,
+         * e.g. a heightmap, should be computed through the chunk's
+         * column_data, see ColumnGenerationData::product.
          */
         template <typename StrategyCandidate>
         concept ChunkGenerationStrategy
-            = requires (StrategyCandidate s, hmem::Handle<Chunk> c) {
-                  {
-                      s.operator()(c)
-                      } -> std::same_as<void>;
-              };
+            = ThreadedChunkGenerationStrategy<StrategyCandidate>
+              || requires (StrategyCandidate s, hmem::Handle<Chunk> c) {
+                     {
+                         s.operator()(c)
+                         } -> std::same_as<void>;
+                 };
 
+        /**
+         * @brief Loads the given chunk as last saved if it was saved whole,
+         * see ChunkGrid::read_saved_record. Otherwise the chunk is left to
+         * be generated, along with the delta to apply once it is if it was
+         * saved as one. The chunk's generation must be active.
+         *
+         * @param chunk The chunk to load.
+         * @param chunk_grid The grid the chunk belongs to.
+         * @param delta Set to the chunk's saved delta, or left empty if it
+         * has none.
+         * @return True if the chunk must be generated, false if it was
+         * loaded.
+         */
+        bool begin_generation(
+            hmem::Handle<Chunk>         chunk,
+            hmem::WeakHandle<ChunkGrid> chunk_grid,
+            OUT std::vector<ui8>&       delta
+        );
+        /**
+         * @brief Applies the given saved delta, if any, to the given chunk,
+         * now generated, and then completes its generation.
+         *
+         * @param chunk The chunk generated.
+         * @param delta The chunk's saved delta, as set by begin_generation.
+         */
+        void end_generation(hmem::Handle<Chunk> chunk, const std::vector<ui8>& delta);
+
+        /**
+         * @brief Loads a chunk as last saved if it has been saved, see
+         * ChunkGrid::read_saved_record, and otherwise generates it with the
+         * given strategy. A chunk saved as a delta is generated with the
+         * strategy and then has the delta applied, so the strategy must be
+         * deterministic.
+         */
         template <hvox::ChunkGenerationStrategy GenerationStrategy>
         class ChunkGenerationTask : public ChunkTask {
         public:
@@ -1,17 +1,24 @@
 template <hvox::ChunkGenerationStrategy GenerationStrategy>
 void hvox::ChunkGenerationTask<
-    GenerationStrategy>::execute(ChunkThreadState*, ChunkTaskQueue*) {
+    GenerationStrategy>::execute(ChunkThreadState* state, ChunkTaskQueue*) {
     auto chunk = m_chunk.lock();
 
     if (chunk == nullptr) return;
 
     chunk->generation.store(ChunkState::ACTIVE, std::memory_order_release);
 
-    const GenerationStrategy generate{};
+    std::vector<ui8> delta;
+    if (begin_generation(chunk, m_chunk_grid, delta)) {
+        const GenerationStrategy generate{};
 
-    generate(chunk);
+        if constexpr (ThreadedChunkGenerationStrategy<GenerationStrategy>) {
+            using ThreadState = typename GenerationStrategy::ThreadState;
 
-    chunk->generation.store(ChunkState::COMPLETE, std::memory_order_release);
+            generate(chunk, state->context.template state<ThreadState>());
+        } else {
+            generate(chunk);
+        }
+    }
 
-    chunk->on_load();
+    end_generation(chunk, delta);
 }
@@ -0,0 +1,75 @@
+#ifndef __hemlock_voxel_generation_noise_h
+#define __hemlock_voxel_generation_noise_h
+
+#include <FastNoise/FastNoise.h>
+
+#include "voxel/block.hpp"
+#include "voxel/block_storage.h"
+
+namespace hemlock {
+    namespace voxel {
+        /**
+         * @brief The best SIMD level the CPU supports, detected the first
+         * time it is asked for.
+         */
+        FastSIMD::eLevel max_noise_simd_level();
+
+        /**
+         * @brief The SIMD level noise node graphs are built for. This is
+         * the best level the CPU supports unless overridden.
+         */
+        FastSIMD::eLevel noise_simd_level();
+
+        /**
+         * @brief Overrides the SIMD level noise node graphs are built for,
+         * e.g. to compare levels when benchmarking. Levels beyond what the
+         * CPU supports are lowered to the best it does support.
+         *
+         * NOTE: Only graphs built after the override take it on, so it is
+         *       best set before any chunk is generated.
+         *
+         * @param level The level to build for, FastSIMD::Level_Null to
+         * return to the best level the CPU supports.
+         */
+        void override_noise_simd_level(FastSIMD::eLevel level);
+
+        /**
+         * @brief Builds a noise node of the given type for the SIMD level
+         * noise is being generated at, see noise_simd_level.
+         *
+         * @tparam NodeType The type of noise node to build.
+         */
+        template <typename NodeType>
+        FastNoise::SmartNode<NodeType> new_noise_node() {
+            return FastNoise::New<NodeType>(noise_simd_level());
+        }
+
+        /**
+         * @brief Sets each block of a chunk by whether its noise is above
+         * the given threshold. A chunk entirely above or below the threshold
+         * is left uniform.
+         *
+         * @param noise The noise of each block of the chunk, in x, then y,
+         * then z order as generated by GenUniformGrid3D.
+         * @param threshold The noise above which blocks are set to above.
+         * @param above The block set where noise is above the threshold.
+         * @param below The block set elsewhere.
+         * @param scratch A buffer of CHUNK_VOLUME blocks to work in.
+         * @param blocks The blocks of the chunk to set.
+         * @param flip_y Whether rows of noise run from the top of the chunk
+         * down rather than from the bottom up.
+         */
+        void threshold_noise(
+            const f32*   noise,
+            f32          threshold,
+            Block        above,
+            Block        below,
+            Block*       scratch,
+            BlockBuffer& blocks,
+            bool         flip_y = false
+        );
+    }  // namespace voxel
+}  // namespace hemlock
+namespace hvox = hemlock::voxel;
+
+#endif  // __hemlock_voxel_generation_noise_h
@@ -26,26 +26,40 @@ void hvox::GreedyMeshStrategy<MeshComparator>::operator()(
     //                      further improve performance and also remove the difficulty
     //                      of the above TODO.
 
-    std::shared_lock<std::shared_mutex> block_lock;
-    auto                                blocks = chunk->blocks.get(block_lock);
-
-    std::queue<BlockChunkPosition> queued_for_visit;
-
-    bool* visited = new bool[CHUNK_VOLUME]{ false };
+    BlockSnapshotHandle block_snapshot;
+    auto&               blocks = chunk->blocks.get(block_snapshot);
 
     chunk->instance.generate_buffer();
 
     std::unique_lock<std::shared_mutex> mesh_lock;
     auto&                               mesh = chunk->instance.get(mesh_lock);
 
+    // Determines if two blocks are of the same mesheable kind.
+    const MeshComparator are_same_meshable{};
+
+    // A uniform chunk is either a single cuboid spanning the whole chunk, or
+    // has nothing to mesh at all.
+    if (blocks.is_uniform()) {
+        const Block* block = &blocks[0];
+        if (are_same_meshable(block, block, {}, chunk.get())) {
+            BlockWorldPosition start_mesh = block_world_position(chunk->position);
+
+            mesh.data[mesh.count++]
+                = ChunkInstanceData{ start_mesh, f32v3{ CHUNK_LENGTH_F } };
+        }
+
+        return;
+    }
+
+    std::queue<BlockChunkPosition> queued_for_visit;
+
+    bool* visited = new bool[CHUNK_VOLUME]{ false };
+
     const Block*       source = &blocks[0];
     BlockChunkPosition start  = BlockChunkPosition{ 0 };
     BlockChunkPosition end    = BlockChunkPosition{ 0 };
     BlockChunkPosition target_pos;
 
-    // Determines if two blocks are of the same mesheable kind.
-    const MeshComparator are_same_meshable{};
-
     auto add_border_blocks_to_queue
         = [&](BlockChunkPosition _start, BlockChunkPosition _end) {
               // Add blocks adjacent to X-face to queue.
@@ -27,6 +27,15 @@ namespace hemlock {
 
             void generate_buffer();
             void free_buffer();
+
+            /**
+             * @brief The number of bytes held by this manager's instance
+             * buffer. Note that this does not take the lock on the buffer,
+             * so it is not necessarily atomically accurate.
+             */
+            size_t allocated_bytes() const {
+                return m_resource.data ? sizeof(ChunkInstanceData) * CHUNK_VOLUME : 0;
+            }
         protected:
             hmem::Handle<ChunkInstanceDataPager> m_data_pager;
         };
@@ -1,6 +1,8 @@
 #ifndef __hemlock_voxel_graphics_mesh_mesh_task_hpp
 #define __hemlock_voxel_graphics_mesh_mesh_task_hpp
 
+#include "voxel/chunk/event/lod_change.hpp"
+#include "voxel/coordinate_system.h"
 #include "voxel/task.hpp"
 
 namespace hemlock {
@@ -23,6 +25,30 @@ namespace hemlock {
                                             } -> std::same_as<void>;
                                     };
 
+        /**
+         * @brief Defines a mesh strategy that can also remesh just the cuboid
+         * of a chunk given by inclusive start and end positions, so long as
+         * the chunk has been meshed before.
+         */
+        template <typename StrategyCandidate>
+        concept PartialChunkMeshStrategy
+            = ChunkMeshStrategy<StrategyCandidate>
+              && requires (
+                  StrategyCandidate       s,
+                  hmem::Handle<ChunkGrid> g,
+                  hmem::Handle<Chunk>     c,
+                  BlockChunkPosition      p
+              ) {
+                     {
+                         s.operator()(g, c, p, p)
+                         } -> std::same_as<void>;
+                 };
+
+        /**
+         * @brief Meshes a chunk with the given strategy. A chunk whose level
+         * of detail is above 0 is instead meshed whole, directly from its
+         * blocks downsampled to the cells of that level, see mesh_cells.
+         */
         template <hvox::ChunkMeshStrategy MeshStrategy>
         class ChunkMeshTask : public ChunkTask {
         public:
@@ -31,6 +57,15 @@ namespace hemlock {
 
             virtual void
             execute(ChunkThreadState* state, ChunkTaskQueue* task_queue) override;
+        protected:
+            /**
+             * @brief Meshes the given chunk at the given level of detail,
+             * from its cells and those of its neighbours bordering it, in
+             * buffers kept by the thread running the task.
+             */
+            void mesh_lod(
+                ChunkThreadState* state, hmem::Handle<Chunk> chunk, LODLevel lod_level
+            ) const;
         };
     }  // namespace voxel
 }  // namespace hemlock
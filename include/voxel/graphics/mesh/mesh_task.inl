@@ -1,6 +1,9 @@
+#include "voxel/chunk/grid.h"
+#include "voxel/chunk/lod.h"
+
 template <hvox::ChunkMeshStrategy MeshStrategy>
 void hvox::ChunkMeshTask<MeshStrategy>::execute(
-    ChunkThreadState* state, ChunkTaskQueue* task_queue
+    ChunkThreadState* state, ChunkTaskQueue*
 ) {
     auto chunk_grid = m_chunk_grid.lock();
     if (chunk_grid == nullptr) return;
@@ -11,18 +14,95 @@ void hvox::ChunkMeshTask<MeshStrategy>::execute(
     const MeshStrategy mesh{};
 
     if (!mesh.can_run(chunk_grid, chunk)) {
-        // Put copy of this mesh task back onto the load task queue.
-        ChunkMeshTask<MeshStrategy>* mesh_task = new ChunkMeshTask<MeshStrategy>();
-        mesh_task->set_state(m_chunk, m_chunk_grid);
-        task_queue->enqueue(state->producer_token, { mesh_task, true });
+        // Requeued, the task would hold its place in the thread pool ahead of
+        // the very generation tasks it waits on. Instead it is dropped, and the
+        // chunk requested again as its neighbours are generated.
+        chunk->mesh_deferred.exchange(true, std::memory_order_acq_rel);
+        chunk->meshing.store(ChunkState::NONE, std::memory_order_release);
+
+        // A neighbour generated since we checked may have found the mesh still
+        // pending, and so not requested it again.
+        if (mesh.can_run(chunk_grid, chunk)
+            && chunk->mesh_deferred.exchange(false, std::memory_order_acq_rel))
+            chunk_grid->request_chunk_task(chunk, ChunkTaskKind::MESH);
         return;
     }
 
+    chunk->mesh_deferred.store(false, std::memory_order_release);
     chunk->meshing.store(ChunkState::ACTIVE, std::memory_order_release);
 
-    mesh(chunk_grid, chunk);
+    const LODLevel lod_level = chunk->lod_level.load(std::memory_order_acquire);
+
+    // Only the blocks changed since the chunk was last meshed need remeshing,
+    // if we know which they are and the strategy can make use of that. The
+    // whole chunk is marked on generation, so its first mesh is always whole.
+    // Coarse meshes are cheap enough that they are always built whole.
+    BlockChunkPosition dirty_start, dirty_end;
+    if (lod_level > 0) {
+        chunk->dirty.mesh.clear();
+
+        mesh_lod(state, chunk, lod_level);
+    } else if (chunk->dirty.mesh.consume(dirty_start, dirty_end)) {
+        if constexpr (PartialChunkMeshStrategy<MeshStrategy>) {
+            mesh(chunk_grid, chunk, dirty_start, dirty_end);
+        } else {
+            mesh(chunk_grid, chunk);
+        }
+    } else {
+        mesh(chunk_grid, chunk);
+    }
 
-    chunk->meshing.store(ChunkState::COMPLETE, std::memory_order_release);
+    // If a remesh was requested while this one ran, run again to pick up any
+    // blocks changed since it began.
+    ChunkState active_state = ChunkState::ACTIVE;
+    if (!chunk->meshing.compare_exchange_strong(
+            active_state, ChunkState::COMPLETE, std::memory_order_acq_rel
+        )
+        && active_state == ChunkState::PENDING)
+        chunk_grid->rerun_chunk_task(chunk, ChunkTaskKind::MESH);
 
     chunk->on_mesh_change();
 }
+
+template <hvox::ChunkMeshStrategy MeshStrategy>
+void hvox::ChunkMeshTask<MeshStrategy>::mesh_lod(
+    ChunkThreadState* state, hmem::Handle<Chunk> chunk, LODLevel lod_level
+) const {
+    LODMeshBuffers& buffers = state->context.template state<LODMeshBuffers>();
+
+    const ui32 length = lod_length(lod_level);
+
+    buffers.cells.resize(static_cast<size_t>(length) * length * length);
+    {
+        BlockSnapshotHandle block_snapshot;
+        downsample_blocks(
+            chunk->blocks.get(block_snapshot), lod_level, buffers.cells.data()
+        );
+    }
+
+    // Cells at the chunk's faces are culled against its neighbours' cells at
+    // the same level of detail, so that no face is left open between them.
+    const Block* layers[6] = {};
+    for (ui8 face = 0; face < 6; ++face) {
+        auto neighbour = chunk->neighbour(face);
+        if (neighbour == nullptr) continue;
+
+        buffers.layers[face].resize(static_cast<size_t>(length) * length);
+
+        BlockSnapshotHandle neighbour_snapshot;
+        downsample_face(
+            neighbour->blocks.get(neighbour_snapshot),
+            lod_level,
+            static_cast<ChunkFace>(face),
+            buffers.layers[face].data()
+        );
+        layers[face] = buffers.layers[face].data();
+    }
+
+    chunk->instance.generate_buffer();
+
+    std::unique_lock<std::shared_mutex> mesh_lock;
+    ChunkInstance&                      mesh = chunk->instance.get(mesh_lock);
+
+    mesh_cells(buffers.cells.data(), layers, lod_level, chunk->position, mesh);
+}
@@ -10,6 +10,23 @@ namespace hemlock {
             bool can_run(hmem::Handle<ChunkGrid> chunk_grid, hmem::Handle<Chunk> chunk) const;
 
             void operator()(hmem::Handle<ChunkGrid> chunk_grid, hmem::Handle<Chunk> chunk) const;
+
+            /**
+             * @brief Remeshes just the blocks in and bordering the cuboid
+             * with the given inclusive start and end positions.
+             */
+            void operator()(
+                hmem::Handle<ChunkGrid> chunk_grid,
+                hmem::Handle<Chunk>     chunk,
+                BlockChunkPosition      dirty_start,
+                BlockChunkPosition      dirty_end
+            ) const;
+        protected:
+            void mesh_region(
+                hmem::Handle<Chunk> chunk,
+                BlockChunkPosition  start,
+                BlockChunkPosition  end
+            ) const;
         };
     }  // namespace voxel
 }  // namespace hemlock
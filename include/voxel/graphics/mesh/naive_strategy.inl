@@ -5,17 +5,12 @@
 
 template <hvox::IdealBlockComparator MeshComparator>
 bool hvox::NaiveMeshStrategy<
-    MeshComparator>::can_run(hmem::Handle<ChunkGrid>, hmem::Handle<Chunk>) const {
+    MeshComparator>::can_run(hmem::Handle<ChunkGrid>, hmem::Handle<Chunk> chunk) const {
     // Only execute if all preloaded neighbouring chunks have at least been
     // generated.
-    // TODO(Matthew): Revisit this. query_all_neighbour_states has been removed, do we
-    //                stand by this? Further, do we stand by the condition here? Perhaps
-    //                we don't really care about the saved vertices.
-    // auto [_, neighbours_in_required_state]
-    //     = chunk_grid->query_all_neighbour_states(chunk, ChunkState::GENERATED);
-
-    // return neighbours_in_required_state;
-    return false;
+    // TODO(Matthew): Do we stand by the condition here? Perhaps we don't really
+    //                care about the saved vertices.
+    return chunk->generated_neighbours.all_linked_reached(FACE_NEIGHBOURS_MASK);
 }
 
 template <hvox::IdealBlockComparator MeshComparator>
@@ -37,6 +32,62 @@ void hvox::NaiveMeshStrategy<MeshComparator>::operator()(
 
     chunk->instance.generate_buffer();
 
+    mesh_region(chunk, BlockChunkPosition{ 0 }, BlockChunkPosition{ CHUNK_LENGTH - 1 });
+}
+
+template <hvox::IdealBlockComparator MeshComparator>
+void hvox::NaiveMeshStrategy<MeshComparator>::operator()(
+    hmem::Handle<ChunkGrid> chunk_grid,
+    hmem::Handle<Chunk>     chunk,
+    BlockChunkPosition      dirty_start,
+    BlockChunkPosition      dirty_end
+) const {
+    // Whether a block is meshed depends on the blocks beside it, so those
+    // bordering the dirty region must be remeshed too.
+    const BlockChunkPosition start
+        = glm::max(dirty_start, BlockChunkPosition{ 1 }) - BlockChunkPosition{ 1 };
+    const BlockChunkPosition end
+        = glm::min(dirty_end, BlockChunkPosition{ CHUNK_LENGTH - 2 })
+          + BlockChunkPosition{ 1 };
+
+    bool has_mesh;
+    {
+        std::unique_lock<std::shared_mutex> mesh_lock;
+        auto&                               mesh = chunk->instance.get(mesh_lock);
+
+        // Drop the instances of blocks in the region, keeping the rest.
+        has_mesh = mesh.data != nullptr;
+        if (has_mesh) {
+            const f32v3 region_start
+                = f32v3(block_world_position(chunk->position, start));
+            const f32v3 region_end = f32v3(block_world_position(chunk->position, end));
+
+            ChunkInstanceData* kept_end = std::remove_if(
+                mesh.data,
+                mesh.data + mesh.count,
+                [&](const ChunkInstanceData& instance) {
+                    return glm::all(
+                               glm::greaterThanEqual(instance.translation, region_start)
+                           )
+                           && glm::all(
+                               glm::lessThanEqual(instance.translation, region_end)
+                           );
+                }
+            );
+            mesh.count = static_cast<ui32>(kept_end - mesh.data);
+        }
+    }
+
+    // If the chunk has not yet been meshed, we mesh it whole.
+    if (!has_mesh) return operator()(chunk_grid, chunk);
+
+    mesh_region(chunk, start, end);
+}
+
+template <hvox::IdealBlockComparator MeshComparator>
+void hvox::NaiveMeshStrategy<MeshComparator>::mesh_region(
+    hmem::Handle<Chunk> chunk, BlockChunkPosition start, BlockChunkPosition end
+) const {
     std::unique_lock<std::shared_mutex> mesh_lock;
     auto&                               mesh = chunk->instance.get(mesh_lock);
 
@@ -49,182 +100,156 @@ void hvox::NaiveMeshStrategy<MeshComparator>::operator()(
 
     Chunk* raw_chunk_ptr = chunk.get();
 
-    std::shared_lock<std::shared_mutex> block_lock;
-    auto                                blocks = chunk->blocks.get(block_lock);
-
-    std::shared_lock<std::shared_mutex> neighbour_lock;
+    BlockSnapshotHandle block_snapshot;
+    auto&               blocks = chunk->blocks.get(block_snapshot);
+
+    // The blocks of each face neighbour are got once for the whole pass, rather
+    // than once for each block on the face.
+    BlockSnapshotHandle neighbour_snapshots[6];
+    const BlockBuffer*  neighbour_blocks[6] = {};
+    for (ui8 face = 0; face < 6; ++face) {
+        auto neighbour = chunk->neighbour(face);
+        if (neighbour)
+            neighbour_blocks[face] = &neighbour->blocks.get(neighbour_snapshots[face]);
+    }
 
-    // TODO(Matthew): Checking block is NULL_BLOCK is wrong check really, we will have
-    // transparent blocks
-    //                e.g. air, to account for too.
-    for (BlockIndex i = 0; i < CHUNK_VOLUME; ++i) {
-        const Block& voxel = blocks[i];
-        if (voxel != NULL_BLOCK) {
-            BlockWorldPosition block_position
-                = block_world_position(chunk->position, i);
-
-            hmem::Handle<Chunk> neighbour;
-
-            // Check its neighbours, to decide whether to add its quads.
-            // LEFT
-            if (is_at_left_face(i)) {
-                // Get corresponding neighbour index in neighbour chunk and check.
-                BlockIndex j = index_at_right_face(i);
-                neighbour    = chunk->neighbours.one.left.lock();
-                if (neighbour) {
-                    auto neighbour_blocks = neighbour->blocks.get(neighbour_lock);
-                    if (neighbour_blocks[j] == NULL_BLOCK) {
-                        add_block(block_position);
-                        continue;
-                    }
-                }
-            } else {
-                // Get corresponding neighbour index in this chunk and check.
-                if (meshable(
-                        &blocks[i - 1],
-                        &blocks[i - 1],
-                        block_chunk_position(i),
-                        raw_chunk_ptr
-                    ))
-                {
-                    add_block(block_position);
-                    continue;
-                }
+    // Determines if any face of the block at the given index is exposed.
+    auto is_exposed = [&](BlockIndex i) {
+        // Check its neighbours, to decide whether to add its quads.
+        // LEFT
+        if (is_at_left_face(i)) {
+            // Get corresponding neighbour index in neighbour chunk and check.
+            BlockIndex j = index_at_right_face(i);
+            auto neighbour = neighbour_blocks[static_cast<ui8>(ChunkFace::LEFT)];
+            if (neighbour && (*neighbour)[j] == NULL_BLOCK) {
+                return true;
             }
+        } else {
+            // Get corresponding neighbour index in this chunk and check.
+            if (meshable(
+                    &blocks[index_left_of(i)],
+                    &blocks[index_left_of(i)],
+                    block_chunk_position(i),
+                    raw_chunk_ptr
+                ))
+            {
+                return true;
+            }
+        }
 
-            // RIGHT
-            if (is_at_right_face(i)) {
-                // Get corresponding neighbour index in neighbour chunk and check.
-                BlockIndex j = index_at_left_face(i);
-                neighbour    = chunk->neighbours.one.right.lock();
-                if (neighbour) {
-                    auto neighbour_blocks = neighbour->blocks.get(neighbour_lock);
-                    if (neighbour_blocks[j] == NULL_BLOCK) {
-                        add_block(block_position);
-                        continue;
-                    }
-                }
-            } else {
-                // Get corresponding neighbour index in this chunk and check.
-                if (meshable(
-                        &blocks[i + 1],
-                        &blocks[i + 1],
-                        block_chunk_position(i),
-                        raw_chunk_ptr
-                    ))
-                {
-                    add_block(block_position);
-                    continue;
-                }
+        // RIGHT
+        if (is_at_right_face(i)) {
+            // Get corresponding neighbour index in neighbour chunk and check.
+            BlockIndex j = index_at_left_face(i);
+            auto neighbour = neighbour_blocks[static_cast<ui8>(ChunkFace::RIGHT)];
+            if (neighbour && (*neighbour)[j] == NULL_BLOCK) {
+                return true;
+            }
+        } else {
+            // Get corresponding neighbour index in this chunk and check.
+            if (meshable(
+                    &blocks[index_right_of(i)],
+                    &blocks[index_right_of(i)],
+                    block_chunk_position(i),
+                    raw_chunk_ptr
+                ))
+            {
+                return true;
             }
+        }
 
-            // BOTTOM
-            if (is_at_bottom_face(i)) {
-                // Get corresponding neighbour index in neighbour chunk and check.
-                BlockIndex j = index_at_top_face(i);
-                neighbour    = chunk->neighbours.one.bottom.lock();
-                if (neighbour) {
-                    auto neighbour_blocks = neighbour->blocks.get(neighbour_lock);
-                    if (neighbour_blocks[j] == NULL_BLOCK) {
-                        add_block(block_position);
-                        continue;
-                    }
-                }
-            } else {
-                // Get corresponding neighbour index in this chunk and check.
-                if (meshable(
-                        &blocks[i - CHUNK_LENGTH],
-                        &blocks[i - CHUNK_LENGTH],
-                        block_chunk_position(i),
-                        raw_chunk_ptr
-                    ))
-                {
-                    add_block(block_position);
-                    continue;
-                }
+        // BOTTOM
+        if (is_at_bottom_face(i)) {
+            // Get corresponding neighbour index in neighbour chunk and check.
+            BlockIndex j = index_at_top_face(i);
+            auto neighbour = neighbour_blocks[static_cast<ui8>(ChunkFace::BOTTOM)];
+            if (neighbour && (*neighbour)[j] == NULL_BLOCK) {
+                return true;
+            }
+        } else {
+            // Get corresponding neighbour index in this chunk and check.
+            if (meshable(
+                    &blocks[index_below(i)],
+                    &blocks[index_below(i)],
+                    block_chunk_position(i),
+                    raw_chunk_ptr
+                ))
+            {
+                return true;
             }
+        }
 
-            // TOP
-            if (is_at_top_face(i)) {
-                // Get corresponding neighbour index in neighbour chunk and check.
-                BlockIndex j = index_at_bottom_face(i);
-                neighbour    = chunk->neighbours.one.top.lock();
-                if (neighbour) {
-                    auto neighbour_blocks = neighbour->blocks.get(neighbour_lock);
-                    if (neighbour_blocks[j] == NULL_BLOCK) {
-                        add_block(block_position);
-                        continue;
-                    }
-                }
-            } else {
-                // Get corresponding neighbour index in this chunk and check.
-                if (meshable(
-                        &blocks[i + CHUNK_LENGTH],
-                        &blocks[i + CHUNK_LENGTH],
-                        block_chunk_position(i),
-                        raw_chunk_ptr
-                    ))
-                {
-                    add_block(block_position);
-                    continue;
-                }
+        // TOP
+        if (is_at_top_face(i)) {
+            // Get corresponding neighbour index in neighbour chunk and check.
+            BlockIndex j = index_at_bottom_face(i);
+            auto neighbour = neighbour_blocks[static_cast<ui8>(ChunkFace::TOP)];
+            if (neighbour && (*neighbour)[j] == NULL_BLOCK) {
+                return true;
             }
+        } else {
+            // Get corresponding neighbour index in this chunk and check.
+            if (meshable(
+                    &blocks[index_above(i)],
+                    &blocks[index_above(i)],
+                    block_chunk_position(i),
+                    raw_chunk_ptr
+                ))
+            {
+                return true;
+            }
+        }
 
-            // FRONT
-            if (is_at_front_face(i)) {
-                // Get corresponding neighbour index in neighbour chunk and check.
-                BlockIndex j = index_at_back_face(i);
-                neighbour    = chunk->neighbours.one.front.lock();
-                if (neighbour) {
-                    auto neighbour_blocks = neighbour->blocks.get(neighbour_lock);
-                    if (neighbour_blocks[j] == NULL_BLOCK) {
-                        add_block(block_position);
-                        continue;
-                    }
-                }
-            } else {
-                // Get corresponding neighbour index in this chunk and check.
-                if (meshable(
-                        &blocks[i - (CHUNK_AREA)],
-                        &blocks[i - (CHUNK_AREA)],
-                        block_chunk_position(i),
-                        raw_chunk_ptr
-                    ))
-                {
-                    add_block(block_position);
-                    continue;
-                }
+        // FRONT
+        if (is_at_front_face(i)) {
+            // Get corresponding neighbour index in neighbour chunk and check.
+            BlockIndex j = index_at_back_face(i);
+            auto neighbour = neighbour_blocks[static_cast<ui8>(ChunkFace::FRONT)];
+            if (neighbour && (*neighbour)[j] == NULL_BLOCK) {
+                return true;
+            }
+        } else {
+            // Get corresponding neighbour index in this chunk and check.
+            if (meshable(
+                    &blocks[index_in_front_of(i)],
+                    &blocks[index_in_front_of(i)],
+                    block_chunk_position(i),
+                    raw_chunk_ptr
+                ))
+            {
+                return true;
             }
+        }
 
-            // BACK
-            if (is_at_back_face(i)) {
-                // Get corresponding neighbour index in neighbour chunk and check.
-                BlockIndex j = index_at_front_face(i);
-                neighbour    = chunk->neighbours.one.back.lock();
-                if (neighbour) {
-                    auto neighbour_blocks = neighbour->blocks.get(neighbour_lock);
-                    if (neighbour_blocks[j] == NULL_BLOCK) {
-                        add_block(block_position);
-                        continue;
-                    }
-                }
-            } else {
-                // Get corresponding neighbour index in this chunk and check.
-                if (meshable(
-                        &blocks[i + (CHUNK_AREA)],
-                        &blocks[i + (CHUNK_AREA)],
-                        block_chunk_position(i),
-                        raw_chunk_ptr
-                    ))
-                {
-                    add_block(block_position);
-                    continue;
-                }
+        // BACK
+        if (is_at_back_face(i)) {
+            // Get corresponding neighbour index in neighbour chunk and check.
+            BlockIndex j = index_at_front_face(i);
+            auto neighbour = neighbour_blocks[static_cast<ui8>(ChunkFace::BACK)];
+            if (neighbour && (*neighbour)[j] == NULL_BLOCK) {
+                return true;
+            }
+        } else {
+            // Get corresponding neighbour index in this chunk and check.
+            if (meshable(
+                    &blocks[index_behind(i)],
+                    &blocks[index_behind(i)],
+                    block_chunk_position(i),
+                    raw_chunk_ptr
+                ))
+            {
+                return true;
             }
         }
-    }
 
-    chunk->meshing.store(ChunkState::COMPLETE, std::memory_order_release);
+        return false;
+    };
 
-    chunk->on_mesh_change();
+    // TODO(Matthew): Checking block is NULL_BLOCK is wrong check really, we will have
+    // transparent blocks
+    //                e.g. air, to account for too.
+    for_each_block_in(start, end, [&](BlockIndex i, BlockChunkPosition position) {
+        if (blocks[i] != NULL_BLOCK && is_exposed(i))
+            add_block(block_world_position(chunk->position, position));
+    });
 }
@@ -3,6 +3,7 @@
 
 #include "graphics/mesh.h"
 #include "timing.h"
+#include "voxel/chunk/event/lod_change.hpp"
 #include "voxel/coordinate_system.h"
 
 namespace hemlock {
@@ -86,6 +87,31 @@ namespace hemlock {
              * @param handle Weak handle on chunk to add.
              */
             void add_chunk(hmem::WeakHandle<Chunk> handle);
+
+            /**
+             * @brief Sets the distance bands of each level of detail. A
+             * chunk further than the Nth distance from every focus point,
+             * along any axis, is drawn at level of detail N + 1, up to
+             * MAX_LOD_LEVEL. With no distances, every chunk is drawn at
+             * full detail.
+             *
+             * @param lod_distances The distances in chunks, in ascending
+             * order.
+             * @param lod_distance_count The number of distances.
+             */
+            void set_lod_distances(const ui32* lod_distances, ui32 lod_distance_count);
+            /**
+             * @brief Sets the points from which the distance of chunks is
+             * measured to pick their level of detail, which is updated for
+             * each chunk on the next update should any point have moved
+             * into another chunk.
+             *
+             * @param focus_points The positions of the focus points.
+             * @param focus_point_count The number of focus points.
+             */
+            void set_focus_points(
+                const ChunkGridPosition* focus_points, ui32 focus_point_count
+            );
         protected:
             static hg::MeshHandles block_mesh_handles;
 
@@ -122,6 +148,18 @@ namespace hemlock {
              */
             void process_pages();
 
+            /**
+             * @brief Gets the level of detail a chunk at the given position
+             * is to be drawn at.
+             */
+            LODLevel lod_level_of(ChunkGridPosition chunk_position) const;
+            /**
+             * @brief Moves each chunk to the level of detail of the distance
+             * band it now lies in, triggering its on_lod_change if that
+             * differs from its last.
+             */
+            void update_lod_levels();
+
             AllPagedChunks      m_all_paged_chunks;
             ChunkRenderPages    m_chunk_pages;
             PagedChunksMetadata m_chunk_metadata;
@@ -130,6 +168,10 @@ namespace hemlock {
 
             ui32 m_page_size;
             ui32 m_max_unused_pages;
+
+            std::vector<ChunkGridPosition> m_focus_points;
+            std::vector<ui32>              m_lod_distances;
+            bool                           m_lods_changed;
         };
     }  // namespace voxel
 }  // namespace hemlock
@@ -2,6 +2,7 @@
 #define __hemlock_voxel_io_chunk_file_task_hpp
 
 #include "io/io_task.hpp"
+#include "voxel/io/region_file.h"
 
 namespace hemlock {
     namespace voxel {
@@ -12,14 +13,22 @@ namespace hemlock {
 
         class ChunkFileTask : public io::IOTask {
         public:
-            void init(hmem::WeakHandle<Chunk> chunk, io::IOManagerBase* iomanager) {
-                io::IOTask::init(iomanager);
+            /**
+             * @brief Sets the chunk the task acts on and the region store
+             * it is loaded from or saved to.
+             *
+             * @param chunk The chunk the task acts on.
+             * @param region_store The store of the chunk's region.
+             */
+            void init(hmem::WeakHandle<Chunk> chunk, ChunkRegionStore* region_store) {
+                io::IOTask::init(region_store->iomanager());
 
-                m_chunk = chunk;
+                m_chunk        = chunk;
+                m_region_store = region_store;
             }
         protected:
             hmem::WeakHandle<Chunk> m_chunk;
-            // static hio::fs::mapped_file chunk_data_file;
+            ChunkRegionStore*       m_region_store;
         };
     }  // namespace voxel
 }  // namespace hemlock
@@ -5,12 +5,19 @@
 
 namespace hemlock {
     namespace voxel {
-        // class ChunkLoadTask : public ChunkFileTask {
-        // public:
-        //     virtual void execute(ChunkFileTaskThreadState* state,
-        //     ChunkFileTaskTaskQueue* task_queue) override;
-        // };
-    }
+        /**
+         * @brief Loads a chunk not yet generated from its region on an IO
+         * thread, completing its generation if it was saved whole. Chunks
+         * that were never saved, or were saved as a delta, are left to be
+         * generated, as are chunks whose generation is already under way.
+         */
+        class ChunkLoadTask : public ChunkFileTask {
+        public:
+            virtual void execute(
+                ChunkFileTaskThreadState* state, ChunkFileTaskTaskQueue* task_queue
+            ) override;
+        };
+    }  // namespace voxel
 }  // namespace hemlock
 namespace hvox = hemlock::voxel;
 
@@ -5,12 +5,18 @@
 
 namespace hemlock {
     namespace voxel {
-        // class ChunkSaveTask : public ChunkFileTask {
-        // public:
-        //     virtual void execute(ChunkFileTaskThreadState* state,
-        //     ChunkFileTaskTaskQueue* task_queue) override;
-        // };
-    }
+        /**
+         * @brief Saves a generated chunk to its region on an IO thread, if
+         * its blocks have changed since it was last generated, loaded or
+         * saved.
+         */
+        class ChunkSaveTask : public ChunkFileTask {
+        public:
+            virtual void execute(
+                ChunkFileTaskThreadState* state, ChunkFileTaskTaskQueue* task_queue
+            ) override;
+        };
+    }  // namespace voxel
 }  // namespace hemlock
 namespace hvox = hemlock::voxel;
 
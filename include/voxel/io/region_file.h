@@ -0,0 +1,294 @@
+#ifndef __hemlock_voxel_io_region_file_h
+#define __hemlock_voxel_io_region_file_h
+
+#include "voxel/block.hpp"
+#include "voxel/chunk/constants.hpp"
+#include "voxel/chunk/edits.hpp"
+#include "voxel/coordinate_system.h"
+
+namespace hemlock {
+    namespace io {
+        class IOManagerBase;
+    }
+
+    namespace voxel {
+        struct Chunk;
+        class BlockBuffer;
+
+        // The number of chunks along each axis of a region.
+        constexpr ui32 REGION_LENGTH = 16;
+        constexpr ui32 REGION_VOLUME = REGION_LENGTH * REGION_LENGTH * REGION_LENGTH;
+
+        /**
+         * @brief Where the record of one chunk of a region lies in its file.
+         * A length of 0 means the chunk has no record.
+         */
+        struct ChunkRegionEntry {
+            ui64 offset;
+            ui32 length;
+            ui32 reserved;
+        };
+
+        /**
+         * @brief The header at the start of each region file, followed by
+         * the records of its chunks.
+         */
+        struct ChunkRegionHeader {
+            ui32 magic;
+            ui32 version;
+            // One past the last byte of the last record appended.
+            ui64 end;
+            // Bytes of records since superseded, reclaimed by compaction.
+            ui64 dead_bytes;
+            // Entries of each chunk of the region, see region_index.
+            ChunkRegionEntry entries[REGION_VOLUME];
+        };
+
+        /**
+         * @brief The encoded blocks of the chunk at a position, see
+         * encode_chunk_record.
+         */
+        struct ChunkRecord {
+            ChunkGridPosition position;
+            std::vector<ui8>  data;
+        };
+
+        /**
+         * @brief Gets the position of the region the chunk at the given
+         * position lies in, in units of regions.
+         */
+        ChunkGridPosition region_position(ChunkGridPosition chunk_position);
+        /**
+         * @brief Gets the index of the chunk at the given position into the
+         * entries of its region.
+         */
+        ui32 region_index(ChunkGridPosition chunk_position);
+
+        /**
+         * @brief Encodes the given blocks as a chunk record: a single block
+         * if the blocks are uniform, otherwise runs of the same block in
+         * block index order.
+         *
+         * @param blocks The blocks to encode.
+         * @param record Set to the encoded record.
+         */
+        void encode_chunk_record(
+            const BlockBuffer& blocks, OUT std::vector<ui8>& record
+        );
+        /**
+         * @brief Encodes the given blocks as a chunk record, as just the
+         * blocks changed since the chunk was generated, each with its
+         * index, if the edits allow it and that is smaller than the whole
+         * record. A delta record holds nothing of the blocks not changed,
+         * so it must be decoded over the chunk as generated anew.
+         *
+         * @param blocks The blocks to encode.
+         * @param edits The blocks changed since the chunk was generated.
+         * @param record Set to the encoded record.
+         */
+        void encode_chunk_record(
+            const BlockBuffer&    blocks,
+            const ChunkEdits&     edits,
+            OUT std::vector<ui8>& record
+        );
+        /**
+         * @brief Whether the given chunk record holds only the blocks
+         * changed since its chunk was generated.
+         */
+        bool is_delta_record(const ui8* record, size_t length);
+        /**
+         * @brief Decodes the given chunk record into the given blocks. A
+         * delta record is applied over the blocks as they are, and its
+         * blocks added to the edits; any other record replaces every block
+         * and marks the edits as covering the whole chunk.
+         *
+         * @param record The record to decode.
+         * @param length The length of the record in bytes.
+         * @param blocks The blocks to decode into.
+         * @param edits The edits of the chunk the blocks belong to.
+         * @return True if the record was well formed and decoded, false
+         * otherwise, in which case the blocks and edits are left untouched.
+         */
+        bool decode_chunk_record(
+            const ui8* record, size_t length, BlockBuffer& blocks, ChunkEdits& edits
+        );
+
+        /**
+         * @brief A memory-mapped file holding the records of the chunks of
+         * one region. Records are only ever appended, with a chunk's entry
+         * pointed at its latest record, and the file is compacted once more
+         * of it is superseded records than live ones.
+         *
+         * NOTE: Any thread may read and write records, reads of records
+         *       proceed together while writes are one at a time.
+         */
+        class ChunkRegionFile {
+        public:
+            ChunkRegionFile();
+
+            ~ChunkRegionFile() { /* Empty. */
+            }
+
+            /**
+             * @brief Opens the region file at the given path, creating it
+             * if it does not yet exist.
+             *
+             * @param iomanager The IO manager through which to map the file.
+             * @param path The path of the file.
+             * @return True if the file was opened, false otherwise.
+             */
+            bool init(io::IOManagerBase* iomanager, const hio::fs::path& path);
+            /**
+             * @brief Closes the region file.
+             */
+            void dispose();
+
+            /**
+             * @brief Copies out the record of the chunk with the given index.
+             *
+             * @param index The index of the chunk in the region.
+             * @param record Set to the chunk's record.
+             * @return True if the chunk has a record, false otherwise.
+             */
+            bool read(ui32 index, OUT std::vector<ui8>& record) const;
+            /**
+             * @brief Appends the given records of chunks of this region,
+             * each superseding any its chunk already had. The file is grown
+             * at most once for all of them.
+             *
+             * @param records The records to write.
+             * @param record_count The number of records.
+             * @return True if the records were written, false otherwise.
+             */
+            bool write(const ChunkRecord* records, size_t record_count);
+
+            /**
+             * @brief Moves every live record to the front of the file, in
+             * the order they lie in, and truncates the file after them.
+             */
+            void compact();
+
+            size_t dead_bytes() const;
+        protected:
+            ChunkRegionHeader* header() {
+                return reinterpret_cast<ChunkRegionHeader*>(m_file.data());
+            }
+
+            const ChunkRegionHeader* header() const {
+                return reinterpret_cast<const ChunkRegionHeader*>(m_file.const_data());
+            }
+
+            /**
+             * @brief Compacts the file, with the lock on it already held.
+             */
+            void compact_locked();
+
+            io::IOManagerBase* m_iomanager;
+            hio::fs::path      m_path;
+
+            mutable std::shared_mutex m_file_mutex;
+            hio::fs::mapped_file      m_file;
+        };
+
+        /**
+         * @brief Saves and loads the blocks of chunks to and from region
+         * files in a directory, opening each region's file as it is first
+         * needed and holding it open until disposed of.
+         *
+         * NOTE: Any thread may save and load chunks.
+         */
+        class ChunkRegionStore {
+        public:
+            ChunkRegionStore();
+
+            ~ChunkRegionStore() { /* Empty. */
+            }
+
+            /**
+             * @brief Initialises the store.
+             *
+             * @param iomanager The IO manager through which to access the
+             * region files.
+             * @param directory The directory holding the region files,
+             * created if it does not yet exist.
+             */
+            void init(io::IOManagerBase* iomanager, const hio::fs::path& directory);
+            /**
+             * @brief Disposes of the store, closing every region file.
+             */
+            void dispose();
+
+            /**
+             * @brief Loads the blocks of the given chunk from its region, if
+             * it has been saved whole.
+             *
+             * @param chunk The chunk to load.
+             * @return True if the chunk's blocks were loaded, false if it
+             * has not been saved, was saved as a delta, which must be
+             * applied over the chunk as generated, or its record could not
+             * be read.
+             */
+            bool load_chunk(hmem::Handle<Chunk> chunk);
+            /**
+             * @brief Copies out the record of the chunk at the given
+             * position, if it has been saved.
+             *
+             * @param chunk_position The position of the chunk.
+             * @param record Set to the chunk's record.
+             * @return True if the chunk has a record, false otherwise.
+             */
+            bool read_record(
+                ChunkGridPosition chunk_position, OUT std::vector<ui8>& record
+            );
+            /**
+             * @brief Saves the blocks of the given chunk to its region, as
+             * a delta where that is smaller.
+             *
+             * @param chunk The chunk to save.
+             * @return True if the chunk's blocks were saved, false
+             * otherwise.
+             */
+            bool save_chunk(hmem::Handle<Chunk> chunk);
+            /**
+             * @brief Saves the given records, writing those of chunks in the
+             * same region together where they are adjacent.
+             *
+             * @param records The records to save.
+             * @param record_count The number of records.
+             * @return True if every record was saved, false otherwise.
+             */
+            bool save_records(const ChunkRecord* records, size_t record_count);
+
+            /**
+             * @brief Compacts every open region file.
+             */
+            void compact();
+
+            io::IOManagerBase* iomanager() const { return m_iomanager; }
+
+            const hio::fs::path& directory() const { return m_directory; }
+        protected:
+            /**
+             * @brief Gets the file of the region the chunk at the given
+             * position lies in, opening it if it is not yet open.
+             *
+             * @param chunk_position The position of the chunk.
+             * @param create Whether to create the file if it does not yet
+             * exist.
+             * @return The region file, nullptr if it does not exist and
+             * was not to be created, or could not be opened.
+             */
+            hmem::Handle<ChunkRegionFile>
+            region(ChunkGridPosition chunk_position, bool create);
+
+            io::IOManagerBase* m_iomanager;
+            hio::fs::path      m_directory;
+
+            std::mutex                                                 m_regions_mutex;
+            std::unordered_map<ChunkID, hmem::Handle<ChunkRegionFile>> m_regions;
+        };
+    }  // namespace voxel
+}  // namespace hemlock
+namespace hvox = hemlock::voxel;
+
+#endif  // __hemlock_voxel_io_region_file_h
@@ -0,0 +1,194 @@
+#ifndef __hemlock_voxel_io_save_queue_h
+#define __hemlock_voxel_io_save_queue_h
+
+#include "io/io_task.hpp"
+#include "timing.h"
+#include "voxel/block_manager.h"
+#include "voxel/io/region_file.h"
+
+namespace hemlock {
+    namespace voxel {
+        struct Chunk;
+        class ChunkSaveQueue;
+
+        /**
+         * @brief The blocks of the chunk at a position as they are to be
+         * saved, along with which of them were changed since the chunk was
+         * generated.
+         */
+        struct ChunkSave {
+            ChunkGridPosition   position;
+            BlockSnapshotHandle blocks;
+            ChunkEdits          edits;
+        };
+
+        /**
+         * @brief Writes a batch of saves, all of chunks of one region, first
+         * to a journal of their own and then to their region file.
+         */
+        class ChunkSaveBatchTask : public io::IOTask {
+        public:
+            void init(ChunkSaveQueue* save_queue, std::vector<ChunkSave>&& saves);
+
+            virtual void
+            execute(io::IOTaskThreadState* state, io::IOTaskTaskQueue* task_queue)
+                override;
+        protected:
+            ChunkSaveQueue*        m_save_queue;
+            std::vector<ChunkSave> m_saves;
+        };
+
+        /**
+         * @brief Saves chunks behind the back of the thread owning them.
+         *
+         * Saves are queued with the blocks to save, which are held as they
+         * are so that the chunk, or its blocks, may be released straight
+         * away. A chunk saved again before its last save was flushed has
+         * only its latest blocks written. Each flush, made once every flush
+         * interval, hands the queued saves to the queue's own IO threads
+         * in one batch per region, which encode them, write them to a
+         * journal of the batch's own and only then write them to their
+         * region file. A journal is removed once its batch and every batch
+         * journalled before it has been written. On being initialised,
+         * anything left in journals, by a crash or a failed write, is
+         * written to its region file, so a crash loses at most the saves
+         * queued since the last flush.
+         *
+         * Until written, queued blocks are what a chunk is loaded as, see
+         * read_record. Blocks handed over are released once written, along
+         * with any page they hold.
+         *
+         * NOTE: Only the thread owning the queue may queue saves, flush
+         *       them or update the queue. Any thread may load chunks.
+         */
+        class ChunkSaveQueue {
+            friend class ChunkSaveBatchTask;
+        public:
+            ChunkSaveQueue();
+
+            ~ChunkSaveQueue() { /* Empty. */
+            }
+
+            /**
+             * @brief Initialises the queue, first writing anything left in
+             * journals to its region file.
+             *
+             * @param region_store The store to write saves to.
+             * @param thread_count The number of IO threads writing saves.
+             * @param flush_interval The time after which queued saves are
+             * flushed.
+             */
+            void init(
+                ChunkRegionStore* region_store,
+                ui32              thread_count   = 1,
+                FrameTime         flush_interval = std::chrono::seconds(1)
+            );
+            /**
+             * @brief Disposes of the queue, flushing every queued save and
+             * waiting for all of them to be written.
+             */
+            void dispose();
+
+            /**
+             * @brief Queues a save of the given blocks of the chunk at the
+             * given position, superseding any save of it not yet flushed.
+             *
+             * @param position The position of the chunk.
+             * @param blocks The blocks of the chunk, e.g. as taken from it
+             * on unload.
+             * @param edits The blocks changed since the chunk was
+             * generated, such that it may be saved as a delta.
+             */
+            void enqueue(
+                ChunkGridPosition position, BlockSnapshotHandle blocks, ChunkEdits edits
+            );
+
+            /**
+             * @brief Flushes queued saves if the flush interval has elapsed
+             * since they were last flushed.
+             *
+             * @param time The time data for the frame.
+             */
+            void update(FrameTime time);
+            /**
+             * @brief Hands every queued save to the IO threads. A chunk
+             * whose last save is still being written stays queued until the
+             * next flush, so that saves of a chunk are written in order.
+             */
+            void flush();
+            /**
+             * @brief Blocks until every flushed save has been written.
+             */
+            void wait();
+
+            /**
+             * @brief Encodes the record of the latest save not yet written
+             * of the chunk at the given position, if there is one.
+             *
+             * @param chunk_position The position of the chunk.
+             * @param record Set to the chunk's record.
+             * @return True if the record was encoded, false if no save of
+             * the chunk is waiting to be written.
+             */
+            bool read_record(
+                ChunkGridPosition chunk_position, OUT std::vector<ui8>& record
+            );
+
+            ChunkRegionStore* region_store() const { return m_region_store; }
+        protected:
+            /**
+             * @brief Writes the given records to a new journal, syncing it
+             * and its directory entry to disk before returning.
+             *
+             * @return The ID of the journal, to be retired once the records
+             * are written to their region file.
+             */
+            ui64 journal(const std::vector<ChunkRecord>& records);
+            /**
+             * @brief Notes the records of the given journal as written,
+             * removing it and any journal after it that is also retired, so
+             * long as no journal before it is still outstanding.
+             *
+             * NOTE: A journal whose records failed to be written is never
+             *       retired, so that it, and any later journal that may
+             *       hold newer saves of the same chunks, are replayed in
+             *       order on the next initialisation.
+             */
+            void retire_journal(ui64 journal);
+            /**
+             * @brief Writes every record of every journal left over to its
+             * region file, in the order journalled, removing the journals
+             * only once all of them are written.
+             */
+            void replay_journals();
+            /**
+             * @brief Notes the given saves as written.
+             */
+            void complete(const std::vector<ChunkSave>& saves);
+
+            ChunkRegionStore* m_region_store;
+            FrameTime         m_flush_interval, m_since_flush;
+
+            thread::ThreadPool<thread::BasicThreadContext> m_thread_pool;
+
+            // Guards the queued and written saves.
+            std::mutex                             m_saves_mutex;
+            std::condition_variable                m_saves_written;
+            std::unordered_map<ChunkID, ChunkSave> m_queued_saves;
+            std::unordered_map<ChunkID, ChunkSave> m_flushed_saves;
+
+            // Batches of saves being flushed, by region.
+            std::unordered_map<ChunkID, std::vector<ChunkSave>> m_batches;
+
+            // Guards the journals not yet removed, by ID, each noted with
+            // whether it has been retired.
+            std::mutex           m_journal_mutex;
+            hio::fs::path        m_journal_directory;
+            ui64                 m_next_journal;
+            std::map<ui64, bool> m_journals;
+        };
+    }  // namespace voxel
+}  // namespace hemlock
+namespace hvox = hemlock::voxel;
+
+#endif  // __hemlock_voxel_io_save_queue_h
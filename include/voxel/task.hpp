@@ -1,6 +1,8 @@
 #ifndef __hemlock_voxel_task_hpp
 #define __hemlock_voxel_task_hpp
 
+#include "voxel/coordinate_system.h"
+
 namespace hemlock {
     namespace voxel {
         struct Chunk;
@@ -11,9 +13,43 @@ namespace hemlock {
             GENERATION,
             MESH,
             MESH_UPLOAD,
+            NAVMESH
+        };
+
+        /**
+         * @brief The context of each thread of a chunk grid's thread pool.
+         * Along with the flags by which the thread is stopped and suspended,
+         * it holds state that tasks keep on the thread from one chunk to the
+         * next, e.g. the node graph and scratch buffers of a generation
+         * strategy, such that it need not be built anew for every chunk.
+         *
+         * NOTE: The context is only ever touched by its own thread, so the
+         *       state it holds needs no synchronisation.
+         */
+        struct ChunkTaskContext : public thread::BasicThreadContext {
+            /**
+             * @brief Gets the state of the given type kept on this thread,
+             * default constructing it the first time it is asked for. Each
+             * thread of the pool thereby builds the state once, when it
+             * first runs a task needing it.
+             *
+             * @tparam StateType The type of state to get.
+             * @return The state of the given type kept on this thread.
+             */
+            template <typename StateType>
+                requires std::is_default_constructible_v<StateType>
+            StateType& state() {
+                auto& handle = states[std::type_index(typeid(StateType))];
+
+                if (handle == nullptr) handle = hmem::make_handle<StateType>();
+
+                return *static_cast<StateType*>(handle.get());
+            }
+
+            // State kept on the thread, one of each type.
+            std::unordered_map<std::type_index, hmem::Handle<void>> states;
         };
 
-        using ChunkTaskContext = thread::BasicThreadContext;
         using ChunkThreadState = thread::Thread<ChunkTaskContext>::State;
         using ChunkTaskQueue   = thread::TaskQueue<ChunkTaskContext>;
 
@@ -22,12 +58,77 @@ namespace hemlock {
             virtual ~ChunkTask() { /* Empty. */
             }
 
+            /**
+             * @brief Sets the chunk and grid the task acts on, capturing
+             * the chunk's task epoch such that the task is cancelled if
+             * the chunk's tasks are cancelled before it runs.
+             *
+             * @param chunk The chunk the task acts on.
+             * @param chunk_grid The grid the chunk belongs to.
+             */
             void set_state(
                 hmem::WeakHandle<Chunk> chunk, hmem::WeakHandle<ChunkGrid> chunk_grid
             );
+
+            /**
+             * @brief Whether the task's chunk has been unloaded, or its
+             * tasks cancelled, since the task was built.
+             */
+            virtual bool is_cancelled() const override;
         protected:
             hmem::WeakHandle<Chunk>     m_chunk;
             hmem::WeakHandle<ChunkGrid> m_chunk_grid;
+            ui32                        m_epoch = 0;
+        };
+
+        /**
+         * @brief A task acting on a run of chunks stacked one on another in
+         * a column, e.g. to generate them together. The task is cancelled
+         * only once every one of its chunks is, and should skip those that
+         * are when run.
+         */
+        class ChunkColumnTask : public ChunkTask {
+        public:
+            virtual ~ChunkColumnTask() { /* Empty. */
+            }
+
+            /**
+             * @brief Sets the chunks and grid the task acts on, capturing
+             * the task epoch of each chunk such that it is skipped if its
+             * tasks are cancelled before the task runs.
+             *
+             * @param chunks The chunks the task acts on, from the bottom up,
+             * each directly above the last.
+             * @param chunk_count The number of chunks.
+             * @param chunk_grid The grid the chunks belong to.
+             */
+            void set_state(
+                const hmem::Handle<Chunk>*  chunks,
+                ui32                        chunk_count,
+                hmem::WeakHandle<ChunkGrid> chunk_grid
+            );
+
+            /**
+             * @brief Whether every one of the task's chunks has been
+             * unloaded, or had its tasks cancelled, since the task was
+             * built.
+             */
+            virtual bool is_cancelled() const override;
+        protected:
+            /**
+             * @brief Gets the chunk at the given index of the run, if it
+             * has been neither unloaded nor had its tasks cancelled since
+             * the task was built.
+             *
+             * @param index The index of the chunk, 0 being the bottom.
+             * @return hmem::Handle<Chunk> The chunk, or nullptr if it was
+             * unloaded or its tasks cancelled.
+             */
+            hmem::Handle<Chunk> live_chunk(ui32 index) const;
+
+            ChunkGridPosition                    m_bottom;
+            std::vector<hmem::WeakHandle<Chunk>> m_chunks;
+            std::vector<ui32>                    m_epochs;
         };
     }  // namespace voxel
 }  // namespace hemlock
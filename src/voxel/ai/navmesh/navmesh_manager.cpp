@@ -23,6 +23,35 @@ void hvox::ai::ChunkNavmeshManager::generate_buffer() {
     }
 }
 
+void hvox::ai::ChunkNavmeshManager::clear() {
+    std::unique_lock lock(m_mutex);
+
+    // The graph's property maps refer into the graph itself, so rather than
+    // assign a fresh navmesh we rebuild it in place.
+    if (m_resource) {
+        m_resource->~ChunkNavmesh();
+
+        new (m_resource) ChunkNavmesh{};
+    }
+}
+
+size_t hvox::ai::ChunkNavmeshManager::allocated_bytes() {
+    std::shared_lock lock(m_mutex);
+
+    if (!m_resource) return 0;
+
+    // NOTE(Matthew): Each node is held in the graph's vertex list and in the
+    //                node-to-vertex map, while each edge is a node of a set;
+    //                we guess at the overhead of each beyond its contents.
+    constexpr size_t BYTES_PER_NODE
+        = 2 * sizeof(ChunkNavmeshNode) + sizeof(ChunkNavmeshVertexDescriptor) + 64;
+    constexpr size_t BYTES_PER_EDGE = sizeof(ChunkNavmeshVertexDescriptor) + 32;
+
+    return sizeof(ChunkNavmesh)
+           + boost::num_vertices(m_resource->graph) * BYTES_PER_NODE
+           + boost::num_edges(m_resource->graph) * BYTES_PER_EDGE;
+}
+
 void hvox::ai::ChunkNavmeshManager::free_buffer() {
     std::unique_lock lock(m_mutex);
 
@@ -2,14 +2,36 @@
 
 #include "voxel/block_manager.h"
 
-void hvox::BlockManager::init(hmem::Handle<ChunkBlockPager> block_pager) {
-    m_block_pager = block_pager;
+hvox::BlockSnapshot::BlockSnapshot(
+    hmem::Handle<ChunkBlockPager> block_pager, ui64 version
+) :
+    m_version(version), m_block_pager(block_pager) {
+    // Empty.
+}
+
+hvox::BlockSnapshot::~BlockSnapshot() {
+    m_blocks.make_uniform(NULL_BLOCK);
+}
+
+void hvox::BlockManager::init(
+    hmem::Handle<ChunkBlockPager> block_pager,
+    BlockStorageKind              storage_kind /*= BlockStorageKind::RAW*/
+) {
+    m_block_pager  = block_pager;
+    m_storage_kind = storage_kind;
 
     generate_buffer();
 }
 
 void hvox::BlockManager::dispose() {
-    free_buffer();
+    {
+        std::unique_lock lock(m_mutex);
+
+        store_published(nullptr);
+
+        m_resource = nullptr;
+        m_superseded.reset();
+    }
 
     m_block_pager = nullptr;
 }
@@ -17,12 +39,159 @@ void hvox::BlockManager::dispose() {
 void hvox::BlockManager::generate_buffer() {
     std::unique_lock lock(m_mutex);
 
-    if (!m_resource) m_resource = m_block_pager->get_page();
+    replace_buffer();
 }
 
 void hvox::BlockManager::free_buffer() {
     std::unique_lock lock(m_mutex);
 
-    if (m_resource) m_block_pager->free_page(m_resource);
-    m_resource = nullptr;
+    replace_buffer();
+}
+
+hvox::BlockBuffer& hvox::BlockManager::get(std::unique_lock<std::shared_mutex>& lock) {
+    lock = std::unique_lock(m_mutex);
+
+    BlockBuffer& buffer = exclusive_buffer();
+
+    // Readers only take the buffer as a snapshot under a shared lock, so
+    // bumping the version while we hold the unique lock ensures no snapshot of
+    // this version is taken before our write completes.
+    m_resource->m_version = m_version.fetch_add(1, std::memory_order_acq_rel) + 1;
+
+    return buffer;
+}
+
+const hvox::BlockBuffer&
+hvox::BlockManager::get(std::shared_lock<std::shared_mutex>& lock) {
+    lock = std::shared_lock(m_mutex);
+
+    return m_resource->m_blocks;
+}
+
+const hvox::BlockBuffer& hvox::BlockManager::get(BlockSnapshotHandle& snapshot) {
+    snapshot = this->snapshot();
+    return snapshot->blocks();
+}
+
+hvox::BlockSnapshotHandle hvox::BlockManager::snapshot() {
+    BlockSnapshotHandle snapshot = load_published();
+    if (snapshot) return snapshot;
+
+    std::shared_lock lock(m_mutex);
+
+    // The buffer has been written to since it was last handed out, but is not
+    // being written to now we hold the lock, so is handed out once more as is.
+    // Other readers may do the same meanwhile, which is harmless.
+    snapshot = m_resource;
+    store_published(snapshot);
+
+    return snapshot;
+}
+
+hvox::BlockSnapshotHandle hvox::BlockManager::take() {
+    std::unique_lock lock(m_mutex);
+
+    // The buffer is handed over whole, still shared with any reader already
+    // holding it.
+    BlockSnapshotHandle taken = m_resource;
+
+    replace_buffer();
+
+    return taken;
+}
+
+bool hvox::BlockManager::collapse_if_uniform() {
+    std::unique_lock lock(m_mutex);
+
+    if (m_resource->m_blocks.is_uniform()) return true;
+
+    return exclusive_buffer().collapse_if_uniform();
+}
+
+bool hvox::BlockManager::compress() {
+    std::unique_lock lock(m_mutex);
+
+    // Only how the blocks are stored changes, not the blocks themselves, so
+    // the version stays the same.
+    return exclusive_buffer().compress();
+}
+
+bool hvox::BlockManager::decompress() {
+    std::unique_lock lock(m_mutex);
+
+    if (m_resource->m_blocks.kind() != BlockStorageKind::PALETTE) return false;
+
+    return exclusive_buffer().decompress();
+}
+
+bool hvox::BlockManager::is_uniform() {
+    std::shared_lock lock(m_mutex);
+
+    return m_resource->m_blocks.is_uniform();
+}
+
+size_t hvox::BlockManager::allocated_bytes() {
+    std::shared_lock lock(m_mutex);
+
+    return m_resource->m_blocks.allocated_bytes();
+}
+
+size_t hvox::BlockManager::snapshot_bytes() {
+    std::shared_lock lock(m_mutex);
+
+    auto superseded = m_superseded.lock();
+    if (superseded == nullptr) return 0;
+
+    return superseded->blocks().allocated_bytes();
+}
+
+void hvox::BlockManager::replace_buffer() {
+    store_published(nullptr);
+
+    const ui64 version = m_version.fetch_add(1, std::memory_order_acq_rel) + 1;
+
+    // Buffers start out uniform and only take a page, or palette, once a
+    // block differing from the uniform block is written.
+    m_resource = hmem::make_handle<BlockSnapshot>(m_block_pager, version);
+    m_resource->m_blocks.m_backing_kind = m_storage_kind;
+    m_resource->m_blocks.m_block_pager  = m_block_pager.get();
+}
+
+hvox::BlockBuffer& hvox::BlockManager::exclusive_buffer() {
+    // No new reader may take the buffer while it is written to.
+    store_published(nullptr);
+
+    // Any reader that took the buffer before now still holds it, and as
+    // snapshots are never written to, we write to a copy of it instead.
+    if (m_resource.use_count() > 1) {
+        auto copy = hmem::make_handle<BlockSnapshot>(
+            m_block_pager, m_resource->m_version
+        );
+        copy->m_blocks.copy_from(m_resource->m_blocks);
+
+        m_superseded = m_resource;
+        m_resource   = copy;
+    }
+
+    return m_resource->m_blocks;
+}
+
+hvox::BlockSnapshotHandle hvox::BlockManager::load_published() {
+#if defined(__cpp_lib_atomic_shared_ptr)
+    return m_published.load(std::memory_order_acquire);
+#else
+    std::lock_guard lock(m_published_mutex);
+
+    return m_published;
+#endif
+}
+
+void hvox::BlockManager::store_published(const BlockSnapshotHandle& snapshot) {
+#if defined(__cpp_lib_atomic_shared_ptr)
+    m_published.store(snapshot, std::memory_order_release);
+#else
+    std::lock_guard lock(m_published_mutex);
+
+    m_published = snapshot;
+#endif
 }
@@ -0,0 +1,270 @@
+#include "stdafx.h"
+
+#include "voxel/chunk/setter.hpp"
+
+#include "voxel/block_storage.h"
+
+// NOTE(Matthew): 16 bits is the widest index we support, which gives space
+//                for every block in a chunk to be distinct so long as chunks
+//                don't grow beyond 65536 blocks.
+static_assert(
+    (CHUNK_VOLUME) <= (1 << 16), "Palette block storage supports at most 2^16 blocks."
+);
+
+void hvox::PaletteBlockStorage::init(Block block /*= NULL_BLOCK*/) {
+    reset(block);
+}
+
+void hvox::PaletteBlockStorage::dispose() {
+    std::vector<Block>().swap(m_palette);
+    std::vector<ui32>().swap(m_counts);
+    std::vector<ui64>().swap(m_indices);
+
+    m_bits       = 0;
+    m_mask       = 0;
+    m_last_entry = 0;
+}
+
+void hvox::PaletteBlockStorage::set(BlockIndex index, Block block) {
+    ui32 old_entry = read_entry(index);
+    if (m_palette[old_entry] == block) return;
+
+    ui32 new_entry = find_or_add_entry(block);
+
+    --m_counts[old_entry];
+    ++m_counts[new_entry];
+
+    write_entry(index, new_entry);
+}
+
+void hvox::PaletteBlockStorage::reset(Block block) {
+    m_palette.assign(1, block);
+    m_palette.shrink_to_fit();
+    m_counts.assign(1, CHUNK_VOLUME);
+    m_counts.shrink_to_fit();
+
+    m_bits       = 1;
+    m_mask       = 0x1;
+    m_last_entry = 0;
+
+    m_indices.assign((CHUNK_VOLUME) / 64, 0);
+    m_indices.shrink_to_fit();
+}
+
+size_t hvox::PaletteBlockStorage::palette_size() const {
+    return static_cast<size_t>(
+        std::count_if(m_counts.begin(), m_counts.end(), [](ui32 count) {
+            return count > 0;
+        })
+    );
+}
+
+size_t hvox::PaletteBlockStorage::allocated_bytes() const {
+    return m_palette.capacity() * sizeof(Block) + m_counts.capacity() * sizeof(ui32)
+           + m_indices.capacity() * sizeof(ui64);
+}
+
+ui32 hvox::PaletteBlockStorage::find_or_add_entry(Block block) {
+    // Runs of the same block are common, so check the entry we last
+    // wrote before doing a full search.
+    if (m_last_entry < m_palette.size() && m_palette[m_last_entry] == block)
+        return m_last_entry;
+
+    ui32 free_entry = std::numeric_limits<ui32>::max();
+    for (ui32 entry = 0; entry < m_palette.size(); ++entry) {
+        if (m_palette[entry] == block) return m_last_entry = entry;
+
+        if (free_entry == std::numeric_limits<ui32>::max() && m_counts[entry] == 0)
+            free_entry = entry;
+    }
+
+    // Reuse any entry whose block no longer appears in the chunk.
+    if (free_entry != std::numeric_limits<ui32>::max()) {
+        m_palette[free_entry] = block;
+        return m_last_entry = free_entry;
+    }
+
+    if (m_palette.size() == (static_cast<size_t>(1) << m_bits)) widen();
+
+    m_palette.emplace_back(block);
+    m_counts.emplace_back(0);
+
+    return m_last_entry = static_cast<ui32>(m_palette.size() - 1);
+}
+
+void hvox::PaletteBlockStorage::widen() {
+    const ui8  new_bits = static_cast<ui8>(m_bits * 2);
+    const ui64 new_mask = (static_cast<ui64>(1) << new_bits) - 1;
+
+    std::vector<ui64> new_indices((CHUNK_VOLUME) * new_bits / 64, 0);
+
+    for (BlockIndex index = 0; index < CHUNK_VOLUME; ++index) {
+        const ui32 bit = index * static_cast<ui32>(new_bits);
+        new_indices[bit >> 6]
+            |= static_cast<ui64>(read_entry(index)) << (bit & 63);
+    }
+
+    m_indices.swap(new_indices);
+    m_bits = new_bits;
+    m_mask = new_mask;
+}
+
+void hvox::BlockBuffer::fill(
+    BlockChunkPosition start, BlockChunkPosition end, Block block
+) {
+    if (start == BlockChunkPosition{ 0 }
+        && end == BlockChunkPosition{ CHUNK_LENGTH - 1 })
+    {
+        make_uniform(block);
+        return;
+    }
+
+    if (m_kind == BlockStorageKind::UNIFORM) {
+        if (block == m_uniform) return;
+
+        expand();
+    }
+
+    if (m_kind == BlockStorageKind::RAW) {
+        set_per_block_data(m_raw, start, end, block);
+        return;
+    }
+
+    for (ui32 z = start.z; z <= end.z; ++z) {
+        for (ui32 y = start.y; y <= end.y; ++y) {
+            for (ui32 x = start.x; x <= end.x; ++x) {
+                m_palette.set(block_index({ x, y, z }), block);
+            }
+        }
+    }
+}
+
+void hvox::BlockBuffer::copy(
+    BlockChunkPosition start, BlockChunkPosition end, Block* blocks
+) {
+    if (m_kind == BlockStorageKind::UNIFORM) expand();
+
+    if (m_kind == BlockStorageKind::RAW) {
+        set_per_block_data(m_raw, start, end, blocks);
+        return;
+    }
+
+    size_t block_idx = 0;
+    for (ui32 z = start.z; z < end.z; ++z) {
+        for (ui32 y = start.y; y < end.y; ++y) {
+            for (ui32 x = start.x; x < end.x; ++x) {
+                m_palette.set(block_index({ x, y, z }), blocks[block_idx++]);
+            }
+        }
+    }
+}
+
+size_t hvox::BlockBuffer::allocated_bytes() const {
+    switch (m_kind) {
+        case BlockStorageKind::RAW:
+            return sizeof(Block) * CHUNK_VOLUME;
+        case BlockStorageKind::PALETTE:
+            return m_palette.allocated_bytes();
+        default:
+            return 0;
+    }
+}
+
+bool hvox::BlockBuffer::collapse_if_uniform() {
+    switch (m_kind) {
+        case BlockStorageKind::RAW:
+            if (std::any_of(m_raw + 1, m_raw + CHUNK_VOLUME, [&](const Block& block) {
+                    return block != m_raw[0];
+                }))
+                return false;
+
+            make_uniform(m_raw[0]);
+            return true;
+        case BlockStorageKind::PALETTE:
+            if (m_palette.palette_size() != 1) return false;
+
+            make_uniform(m_palette.get(0));
+            return true;
+        default:
+            return true;
+    }
+}
+
+bool hvox::BlockBuffer::compress() {
+    if (m_kind != BlockStorageKind::RAW) return false;
+
+    m_palette.init(m_raw[0]);
+    for (BlockIndex index = 1; index < CHUNK_VOLUME; ++index)
+        m_palette.set(index, m_raw[index]);
+
+    // A chunk of many distinct blocks can take up more memory as a palette
+    // than it does raw.
+    if (m_palette.allocated_bytes() >= sizeof(Block) * CHUNK_VOLUME) {
+        m_palette.dispose();
+        return false;
+    }
+
+    m_block_pager->free_page(m_raw);
+    m_raw  = nullptr;
+    m_kind = BlockStorageKind::PALETTE;
+
+    return true;
+}
+
+bool hvox::BlockBuffer::decompress() {
+    if (m_kind != BlockStorageKind::PALETTE || m_backing_kind != BlockStorageKind::RAW)
+        return false;
+
+    m_raw = m_block_pager->get_page();
+    for (BlockIndex index = 0; index < CHUNK_VOLUME; ++index)
+        m_raw[index] = m_palette.get(index);
+
+    m_palette.dispose();
+    m_kind = BlockStorageKind::RAW;
+
+    return true;
+}
+
+void hvox::BlockBuffer::expand() {
+    if (m_kind != BlockStorageKind::UNIFORM) return;
+
+    if (m_backing_kind == BlockStorageKind::RAW) {
+        m_raw = m_block_pager->get_page();
+        std::fill_n(m_raw, CHUNK_VOLUME, m_uniform);
+    } else {
+        m_palette.init(m_uniform);
+    }
+
+    m_kind = m_backing_kind;
+}
+
+void hvox::BlockBuffer::make_uniform(Block block) {
+    if (m_raw) m_block_pager->free_page(m_raw);
+    m_raw = nullptr;
+
+    m_palette.dispose();
+
+    m_kind    = BlockStorageKind::UNIFORM;
+    m_uniform = block;
+}
+
+void hvox::BlockBuffer::copy_from(const BlockBuffer& source) {
+    make_uniform(source.m_uniform);
+
+    m_backing_kind = source.m_backing_kind;
+    m_block_pager  = source.m_block_pager;
+
+    switch (source.m_kind) {
+        case BlockStorageKind::RAW:
+            m_raw = m_block_pager->get_page();
+            std::copy_n(source.m_raw, CHUNK_VOLUME, m_raw);
+            break;
+        case BlockStorageKind::PALETTE:
+            m_palette = source.m_palette;
+            break;
+        default:
+            break;
+    }
+
+    m_kind = source.m_kind;
+}
@@ -8,11 +8,14 @@ hvox::Chunk::Chunk() :
     neighbours({}),
     blocks{},
     navmesh{},
+    task_epoch(0),
+    saved_version(0),
     lod_level(0),
     generation(ChunkState::NONE),
     meshing(ChunkState::NONE),
     mesh_uploading(ChunkState::NONE),
     navmeshing(ChunkState::NONE),
+    mesh_deferred(false),
     navmesh_stitch{ ChunkState::NONE, ChunkState::NONE, ChunkState::NONE,
                     ChunkState::NONE, ChunkState::NONE, ChunkState::NONE,
                     ChunkState::NONE, ChunkState::NONE, ChunkState::NONE,
@@ -34,11 +37,12 @@ void hvox::Chunk::init(
     hmem::WeakHandle<Chunk>              self,
     hmem::Handle<ChunkBlockPager>        block_pager,
     hmem::Handle<ChunkInstanceDataPager> instance_data_pager,
-    hmem::Handle<ai::ChunkNavmeshPager>  navmesh_pager
+    hmem::Handle<ai::ChunkNavmeshPager>  navmesh_pager,
+    BlockStorageKind                     block_storage_kind /*= BlockStorageKind::RAW*/
 ) {
     init_events(self);
 
-    blocks.init(block_pager);
+    blocks.init(block_pager, block_storage_kind);
 
     instance.init(instance_data_pager);
 
@@ -46,6 +50,84 @@ void hvox::Chunk::init(
     navmesh.generate_buffer();
 
     neighbours = {};
+    generated_neighbours.clear();
+}
+
+void hvox::Chunk::mark_dirty(BlockChunkPosition start, BlockChunkPosition end) {
+    dirty.mesh.mark(start, end);
+    dirty.navmesh.mark(start, end);
+    dirty.column.mark(start, end);
+
+    // Blocks set while generating are had again just by generating anew.
+    if (generation.load(std::memory_order_acquire) != ChunkState::ACTIVE)
+        edits.mark(start, end);
+
+    ui8 faces = faces_reached(start, end);
+    if (faces == 0) return;
+
+    auto mark_neighbour = [&](ChunkFace          face,
+                              BlockChunkPosition neighbour_start,
+                              BlockChunkPosition neighbour_end) {
+        if (!(faces & (1 << static_cast<ui8>(face)))) return;
+
+        auto neighbour = this->neighbour(face);
+        if (neighbour) neighbour->dirty.mesh.mark(neighbour_start, neighbour_end);
+    };
+
+    constexpr BlockChunkPositionCoord LAST = CHUNK_LENGTH - 1;
+
+    mark_neighbour(ChunkFace::LEFT, { LAST, start.y, start.z }, { LAST, end.y, end.z });
+    mark_neighbour(ChunkFace::RIGHT, { 0, start.y, start.z }, { 0, end.y, end.z });
+    mark_neighbour(ChunkFace::TOP, { start.x, 0, start.z }, { end.x, 0, end.z });
+    mark_neighbour(
+        ChunkFace::BOTTOM, { start.x, LAST, start.z }, { end.x, LAST, end.z }
+    );
+    mark_neighbour(ChunkFace::FRONT, { start.x, start.y, 0 }, { end.x, end.y, 0 });
+    mark_neighbour(
+        ChunkFace::BACK, { start.x, start.y, LAST }, { end.x, end.y, LAST }
+    );
+}
+
+void hvox::Chunk::complete_generation() {
+    // Most chunks are entirely one block, e.g. air or stone, and so we release
+    // their block buffer in favour of holding just that block.
+    blocks.collapse_if_uniform();
+
+    // Blocks as generated or loaded can always be had again, so needn't be
+    // saved until changed.
+    saved_version.store(blocks.version(), std::memory_order_release);
+
+    // Every block is new, so the chunk must be meshed, navmeshed and summarised
+    // whole.
+    dirty.mesh.mark_all();
+    dirty.navmesh.mark_all();
+    dirty.column.mark_all();
+
+    {
+        // Neighbours are linked under the locks on both chunks' neighbours, so
+        // holding ours here, any neighbour is either linked after this store
+        // and sees it or before and is told of it below.
+        std::shared_lock lock(neighbours_mutex);
+
+        generation.store(ChunkState::COMPLETE, std::memory_order_release);
+
+        // Let each loaded neighbour know this chunk is now generated.
+        for (ui8 index = 0; index < NEIGHBOUR_COUNT; ++index) {
+            auto neighbour = neighbours.all[index].lock();
+            if (neighbour)
+                neighbour->generated_neighbours.set_reached(
+                    opposite_neighbour(index)
+                );
+        }
+    }
+
+    on_load();
+}
+
+hmem::Handle<hvox::Chunk> hvox::Chunk::neighbour(ui8 index) {
+    std::shared_lock lock(neighbours_mutex);
+
+    return neighbours.all[index].lock();
 }
 
 void hvox::Chunk::update(FrameTime) {
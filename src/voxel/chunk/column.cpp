@@ -0,0 +1,205 @@
+#include "stdafx.h"
+
+#include "voxel/chunk/chunk.h"
+
+#include "voxel/chunk/column.h"
+
+static hvox::BlockChunkPositionCoord local_coord(hvox::BlockWorldPositionCoord coord) {
+    return static_cast<hvox::BlockChunkPositionCoord>(
+        (coord % CHUNK_LENGTH + CHUNK_LENGTH) % CHUNK_LENGTH
+    );
+}
+
+static i32 column_coord(hvox::BlockWorldPositionCoord coord) {
+    return (coord - static_cast<i32>(local_coord(coord))) / CHUNK_LENGTH;
+}
+
+hvox::ColumnMetadata::ColumnMetadata() {
+    std::fill_n(heights, CHUNK_AREA, ColumnMetadataCache::NO_SURFACE);
+}
+
+void hvox::ColumnMetadataCache::dispose() {
+    std::lock_guard<std::mutex>         update_lock(m_update_mutex);
+    std::unique_lock<std::shared_mutex> lock(m_columns_mutex);
+
+    std::unordered_map<ColumnID, ColumnMetadata>().swap(m_columns);
+}
+
+void hvox::ColumnMetadataCache::add_chunk(hmem::Handle<Chunk> chunk) {
+    std::lock_guard<std::mutex>         update_lock(m_update_mutex);
+    std::unique_lock<std::shared_mutex> lock(m_columns_mutex);
+
+    auto& column = m_columns[column_position(chunk->position).id];
+
+    // A chunk reloaded at the same position starts over.
+    auto& summary = column.chunks[chunk->position.y];
+    summary       = ChunkColumnSummary{};
+    summary.chunk = chunk;
+}
+
+void hvox::ColumnMetadataCache::remove_chunk(ChunkGridPosition chunk_position) {
+    std::lock_guard<std::mutex>         update_lock(m_update_mutex);
+    std::unique_lock<std::shared_mutex> lock(m_columns_mutex);
+
+    auto it = m_columns.find(column_position(chunk_position).id);
+    if (it == m_columns.end()) return;
+
+    ColumnMetadata& column = it->second;
+    if (column.chunks.erase(chunk_position.y) == 0) return;
+
+    if (column.chunks.empty()) {
+        m_columns.erase(it);
+        return;
+    }
+
+    refresh_heights(
+        column, BlockChunkPosition{ 0 }, BlockChunkPosition{ CHUNK_LENGTH - 1 }
+    );
+}
+
+void hvox::ColumnMetadataCache::update_chunk(hmem::Handle<Chunk> chunk) {
+    std::lock_guard<std::mutex> update_lock(m_update_mutex);
+
+    // Only adds, removes and updates change the columns, and we hold off all
+    // of those, so we may look the summary up without locking.
+    auto column_it = m_columns.find(column_position(chunk->position).id);
+    if (column_it == m_columns.end()) return;
+
+    ColumnMetadata& column     = column_it->second;
+    auto            summary_it = column.chunks.find(chunk->position.y);
+    // Stale chunks, unloaded since the update was asked for, are ignored.
+    if (summary_it == column.chunks.end() || summary_it->second.chunk.lock() != chunk)
+        return;
+
+    ChunkColumnSummary& summary = summary_it->second;
+
+    // Consuming the dirty region before taking the lock on the blocks means
+    // the scan sees every change the region was marked for.
+    BlockChunkPosition start, end;
+    bool               is_dirty = chunk->dirty.column.consume(start, end);
+    if (!summary.scanned) {
+        start = BlockChunkPosition{ 0 };
+        end   = BlockChunkPosition{ CHUNK_LENGTH - 1 };
+    } else if (!is_dirty) {
+        return;
+    }
+
+    ui8 heights[CHUNK_AREA];
+    ui8 solid_counts[CHUNK_AREA];
+    {
+        std::shared_lock<std::shared_mutex> lock;
+        const BlockBuffer&                  blocks = chunk->blocks.get(lock);
+
+        const bool is_uniform       = blocks.is_uniform();
+        const bool is_uniform_solid = is_uniform && blocks[0] != NULL_BLOCK;
+
+        for (BlockChunkPositionCoord z = start.z; z <= end.z; ++z) {
+            for (BlockChunkPositionCoord x = start.x; x <= end.x; ++x) {
+                const ui32 idx = x + z * CHUNK_LENGTH;
+
+                if (is_uniform) {
+                    heights[idx]      = is_uniform_solid ? CHUNK_LENGTH : 0;
+                    solid_counts[idx] = is_uniform_solid ? CHUNK_LENGTH : 0;
+                    continue;
+                }
+
+                ui8 height = 0, solid_count = 0;
+                for (ui32 y = CHUNK_LENGTH; y > 0; --y) {
+                    BlockChunkPosition position{
+                        x, static_cast<BlockChunkPositionCoord>(y - 1), z
+                    };
+                    if (blocks[block_index(position)] == NULL_BLOCK) continue;
+
+                    if (height == 0) height = static_cast<ui8>(y);
+                    ++solid_count;
+                }
+
+                heights[idx]      = height;
+                solid_counts[idx] = solid_count;
+            }
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(m_columns_mutex);
+
+    for (BlockChunkPositionCoord z = start.z; z <= end.z; ++z) {
+        for (BlockChunkPositionCoord x = start.x; x <= end.x; ++x) {
+            const ui32 idx = x + z * CHUNK_LENGTH;
+
+            summary.solid_count
+                = summary.solid_count - summary.solid_counts[idx] + solid_counts[idx];
+            summary.solid_counts[idx] = solid_counts[idx];
+            summary.heights[idx]      = heights[idx];
+        }
+    }
+    summary.scanned = true;
+
+    refresh_heights(column, start, end);
+}
+
+hvox::ChunkContent
+hvox::ColumnMetadataCache::content(ChunkGridPosition chunk_position) const {
+    std::shared_lock<std::shared_mutex> lock(m_columns_mutex);
+
+    auto column_it = m_columns.find(column_position(chunk_position).id);
+    if (column_it == m_columns.end()) return ChunkContent::UNKNOWN;
+
+    auto summary_it = column_it->second.chunks.find(chunk_position.y);
+    if (summary_it == column_it->second.chunks.end() || !summary_it->second.scanned)
+        return ChunkContent::UNKNOWN;
+
+    const ui32 solid_count = summary_it->second.solid_count;
+    if (solid_count == 0) return ChunkContent::EMPTY;
+    if (solid_count == CHUNK_VOLUME) return ChunkContent::SOLID;
+    return ChunkContent::MIXED;
+}
+
+bool hvox::ColumnMetadataCache::surface_height(
+    BlockWorldPositionCoord x,
+    BlockWorldPositionCoord z,
+    OUT BlockWorldPositionCoord& height
+) const {
+    ColumnWorldPosition column_position;
+    column_position.x = column_coord(x);
+    column_position.z = column_coord(z);
+
+    std::shared_lock<std::shared_mutex> lock(m_columns_mutex);
+
+    auto it = m_columns.find(column_position.id);
+    if (it == m_columns.end()) return false;
+
+    BlockWorldPositionCoord column_height
+        = it->second.heights[local_coord(x) + local_coord(z) * CHUNK_LENGTH];
+    if (column_height == NO_SURFACE) return false;
+
+    height = column_height;
+    return true;
+}
+
+size_t hvox::ColumnMetadataCache::column_count() const {
+    std::shared_lock<std::shared_mutex> lock(m_columns_mutex);
+
+    return m_columns.size();
+}
+
+void hvox::ColumnMetadataCache::refresh_heights(
+    ColumnMetadata& column, BlockChunkPosition start, BlockChunkPosition end
+) {
+    for (BlockChunkPositionCoord z = start.z; z <= end.z; ++z) {
+        for (BlockChunkPositionCoord x = start.x; x <= end.x; ++x) {
+            const ui32 idx = x + z * CHUNK_LENGTH;
+
+            // The highest chunk with any solid block at (x, z) holds the
+            // surface, so search down from the top of the column.
+            column.heights[idx] = NO_SURFACE;
+            for (auto it = column.chunks.rbegin(); it != column.chunks.rend(); ++it) {
+                if (it->second.heights[idx] == 0) continue;
+
+                column.heights[idx]
+                    = static_cast<BlockWorldPositionCoord>(it->first) * CHUNK_LENGTH
+                      + it->second.heights[idx] - 1;
+                break;
+            }
+        }
+    }
+}
@@ -0,0 +1,76 @@
+#include "stdafx.h"
+
+#include "voxel/chunk/chunk.h"
+
+#include "voxel/chunk/edit_batch.h"
+
+void hvox::BlockEditBatch::set_block(
+    hmem::Handle<Chunk> chunk, BlockChunkPosition position, Block block
+) {
+    set_blocks(chunk, position, position, block);
+}
+
+void hvox::BlockEditBatch::set_blocks(
+    hmem::Handle<Chunk> chunk,
+    BlockChunkPosition  start,
+    BlockChunkPosition  end,
+    Block               block
+) {
+    auto [it, added] = m_chunk_edits.try_emplace(chunk->id());
+
+    ChunkEdits& chunk_edits = it->second;
+    if (added) {
+        chunk_edits.chunk = chunk;
+        chunk_edits.start = start;
+        chunk_edits.end   = end;
+    } else {
+        chunk_edits.start = glm::min(chunk_edits.start, start);
+        chunk_edits.end   = glm::max(chunk_edits.end, end);
+    }
+
+    chunk_edits.edits.emplace_back(BlockEdit{ start, end, block });
+}
+
+ui32 hvox::BlockEditBatch::commit() {
+    ui32 applied_count = 0;
+
+    for (auto& [id, chunk_edits] : m_chunk_edits) {
+        auto& chunk = chunk_edits.chunk;
+
+        bool gen_task_active
+            = chunk->generation.load(std::memory_order_acquire) == ChunkState::ACTIVE;
+        if (!gen_task_active) {
+            bool should_cancel = chunk->on_bulk_block_change(
+                { nullptr,
+                  false,
+                  chunk_edits.start,
+                  chunk_edits.end,
+                  chunk_edits.edits.data(),
+                  chunk_edits.edits.size() }
+            );
+            if (should_cancel) continue;
+        }
+
+        std::unique_lock<std::shared_mutex> lock;
+        auto&                               blocks = chunk->blocks.get(lock);
+
+        // Each edit is marked dirty on its own, as the box bounding all of a
+        // chunk's edits can span much of the chunk even when few blocks
+        // changed, and every block in it would be recorded as edited.
+        for (auto& edit : chunk_edits.edits) {
+            if (edit.start == edit.end) {
+                blocks.set(block_index(edit.start), edit.block);
+            } else {
+                blocks.fill(edit.start, edit.end, edit.block);
+            }
+
+            chunk->mark_dirty(edit.start, edit.end);
+        }
+
+        ++applied_count;
+    }
+
+    m_chunk_edits.clear();
+
+    return applied_count;
+}
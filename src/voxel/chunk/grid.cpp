@@ -10,14 +10,57 @@ void hvox::ChunkTask::set_state(
 ) {
     m_chunk      = chunk;
     m_chunk_grid = chunk_grid;
+
+    auto locked_chunk = chunk.lock();
+    if (locked_chunk)
+        m_epoch = locked_chunk->task_epoch.load(std::memory_order_acquire);
+}
+
+bool hvox::ChunkTask::is_cancelled() const {
+    auto chunk = m_chunk.lock();
+    if (chunk == nullptr) return true;
+
+    return chunk->task_epoch.load(std::memory_order_acquire) != m_epoch;
+}
+
+void hvox::ChunkColumnTask::set_state(
+    const hmem::Handle<Chunk>*  chunks,
+    ui32                        chunk_count,
+    hmem::WeakHandle<ChunkGrid> chunk_grid
+) {
+    ChunkTask::set_state(chunks[0], chunk_grid);
+
+    m_bottom = chunks[0]->position;
+
+    m_chunks.clear();
+    m_epochs.clear();
+    m_chunks.reserve(chunk_count);
+    m_epochs.reserve(chunk_count);
+    for (ui32 i = 0; i < chunk_count; ++i) {
+        m_chunks.emplace_back(chunks[i]);
+        m_epochs.emplace_back(chunks[i]->task_epoch.load(std::memory_order_acquire));
+    }
+}
+
+bool hvox::ChunkColumnTask::is_cancelled() const {
+    for (ui32 i = 0; i < m_chunks.size(); ++i) {
+        if (live_chunk(i) != nullptr) return false;
+    }
+
+    return true;
+}
+
+hmem::Handle<hvox::Chunk> hvox::ChunkColumnTask::live_chunk(ui32 index) const {
+    auto chunk = m_chunks[index].lock();
+    if (chunk == nullptr) return nullptr;
+
+    if (chunk->task_epoch.load(std::memory_order_acquire) != m_epochs[index])
+        return nullptr;
+
+    return chunk;
 }
 
 hvox::ChunkGrid::ChunkGrid() :
-    // TODO(Matthew): both of these are rather inefficient, we remesh literally every
-    // block change, rather than
-    //                once per update loop, likewise with chunk loads.
-    // TODO(Matthew): as these are called in threadpool threads, we'd like them to
-    //                be able to use the appropriate producer tokens.
     handle_chunk_load(Delegate<void(Sender)>{ [&](Sender sender) {
         hmem::WeakHandle<Chunk> handle = sender.get_handle<Chunk>();
 
@@ -27,49 +70,56 @@ hvox::ChunkGrid::ChunkGrid() :
         // an unload event for this chunk.
         if (chunk == nullptr) return;
 
-        auto mesh_task = m_build_mesh_task();
-        mesh_task->set_state(chunk, m_self);
-        m_thread_pool.threadsafe_add_task({ mesh_task, true });
+        // Summarise the chunk before meshing and navmeshing, which may then
+        // make use of the summary.
+        m_columns.update_chunk(chunk);
 
-        if (m_build_navmesh_task) {
-            auto navmesh_task = m_build_navmesh_task();
-            navmesh_task->set_state(chunk, m_self);
-            m_thread_pool.threadsafe_add_task({ navmesh_task, true });
+        request_chunk_task(chunk, ChunkTaskKind::MESH);
+        request_chunk_task(chunk, ChunkTaskKind::NAVMESH);
+
+        // Neighbours may have been waiting on the chunk to be generated.
+        for (ui8 face = 0; face < 6; ++face) {
+            auto neighbour = chunk->neighbour(face);
+            if (neighbour) request_deferred_mesh(neighbour);
         }
     } }),
-    // TODO(Matthew): handle bulk block change too.
     // TODO(Matthew): right now we remesh even if block change is cancelled.
-    //                perhaps we can count changes and if at least 1 change
-    //                on end of update loop then schedule remesh, only
-    //                incrementing if block change actually occurs
-    //                  i.e. stop queuing here.
+    //                perhaps we can have a post-change event to subscribe to
+    //                instead.
     handle_block_change(Delegate<bool(Sender, BlockChangeEvent)>{
-        [&](Sender sender, BlockChangeEvent) {
-            hmem::WeakHandle<Chunk> handle = sender.get_handle<Chunk>();
-
-            auto chunk = handle.lock();
-            // If chunk is nullptr, then there's no point
-            // handling the block change as we will have
-            // an unload event for this chunk.
-            if (chunk == nullptr) return true;
-
-            // TODO(Matthew): These tasks are being added in the wrong event - this
-            //                is the pre-block change event checking if the change may
-            //                occur, in fact we should do this only after the block
-            //                change has occurred.
-
-            auto mesh_task = m_build_mesh_task();
-            mesh_task->set_state(chunk, m_self);
-            m_thread_pool.add_task({ mesh_task, true });
-
-            if (m_build_navmesh_task) {
-                auto navmesh_task = m_build_navmesh_task();
-                navmesh_task->set_state(chunk, m_self);
-                m_thread_pool.threadsafe_add_task({ navmesh_task, true });
-            }
+        [&](Sender sender, BlockChangeEvent event) {
+            mark_chunk_changed(
+                sender.get_handle<Chunk>(), event.block_position, event.block_position
+            );
+
+            return false;
+        } }),
+    handle_bulk_block_change(Delegate<bool(Sender, BulkBlockChangeEvent)>{
+        [&](Sender sender, BulkBlockChangeEvent event) {
+            mark_chunk_changed(
+                sender.get_handle<Chunk>(), event.start_position, event.end_position
+            );
 
             return false;
-        } }) {
+        } }),
+    handle_lod_change(Delegate<void(Sender, LODChangeEvent)>{
+        [&](Sender sender, LODChangeEvent) {
+            auto chunk = sender.get_handle<Chunk>().lock();
+            if (chunk == nullptr) return;
+
+            // Chunks not yet generated are meshed at their new level of
+            // detail once they are.
+            if (chunk->generation.load(std::memory_order_acquire)
+                != ChunkState::COMPLETE)
+                return;
+
+            // The mesh is of another level of detail entirely, so none of it
+            // may be kept.
+            chunk->dirty.mesh.mark_all();
+
+            request_chunk_task(chunk, ChunkTaskKind::MESH);
+        } }),
+    m_max_column_chunks(8) {
     // Empty.
 }
 
@@ -79,13 +129,18 @@ void hvox::ChunkGrid::init(
     ui32                        thread_count,
     ChunkTaskBuilder            build_load_or_generate_task,
     ChunkTaskBuilder            build_mesh_task,
-    ChunkTaskBuilder*           build_navmesh_task /* = nullptr*/
+    ChunkTaskBuilder*           build_navmesh_task /* = nullptr*/,
+    BlockStorageKind            block_storage_kind /*= BlockStorageKind::RAW*/
 ) {
     m_self = self;
 
+    m_block_storage_kind = block_storage_kind;
+
     m_render_distance           = render_distance;
     m_chunks_in_render_distance = render_distance * render_distance * render_distance;
 
+    m_chunks.resize(render_distance);
+
     m_build_load_or_generate_task = build_load_or_generate_task;
     m_build_mesh_task             = build_mesh_task;
     if (build_navmesh_task) {
@@ -93,6 +148,9 @@ void hvox::ChunkGrid::init(
     }
 
     m_thread_pool.init(thread_count);
+    // Keep enough tasks queued that threads don't sit idle between updates,
+    // but few enough that the rest may still be reprioritised.
+    m_scheduler.init(&m_thread_pool, 8 * thread_count);
 
     m_block_pager    = hmem::make_handle<ChunkBlockPager>();
     m_instance_pager = hmem::make_handle<ChunkInstanceDataPager>();
@@ -105,16 +163,38 @@ void hvox::ChunkGrid::init(
 
 void hvox::ChunkGrid::dispose() {
     m_thread_pool.dispose();
+    m_scheduler.dispose();
+
+    std::vector<hmem::Handle<Chunk>>().swap(m_pending_generation);
+
+    // With no task left to change them, changes to chunks still loaded would
+    // otherwise be lost.
+    for (auto& [id, chunk] : m_chunks) save_unloaded_chunk(chunk);
+
+    m_columns.dispose();
+    m_column_generation_cache.dispose();
 
     m_renderer.dispose();
 }
 
 void hvox::ChunkGrid::update(FrameTime time) {
-    for (auto chunk : m_chunks) {
-        chunk.second->update(time);
+    for (auto& [id, chunk] : m_chunks) {
+        chunk->update(time);
     }
 
+    schedule_column_generation();
+
+    // Rehydrate chunks needed since the last update before remeshing those
+    // changed, so that any whose instance data was dropped is remeshed whole.
+    if (m_residency_manager) m_residency_manager->update();
+
+    schedule_changed_chunks();
+
+    m_scheduler.dispatch();
+
     m_renderer.update(time);
+
+    if (m_save_queue) m_save_queue->update(time);
 }
 
 void hvox::ChunkGrid::draw(FrameTime time) {
@@ -133,36 +213,70 @@ void hvox::ChunkGrid::set_render_distance(ui32 render_distance) {
 
     m_render_distance           = render_distance;
     m_chunks_in_render_distance = chunks_in_render_distance;
+
+    m_chunks.resize(render_distance);
+}
+
+void hvox::ChunkGrid::set_column_generation_task_builder(
+    ChunkColumnTaskBuilder* build_column_generation_task,
+    ui32                    max_column_chunks /*= 8*/
+) {
+    // Chunks held for batching must not be lost by a switch to loading each
+    // chunk alone.
+    schedule_column_generation();
+
+    if (build_column_generation_task) {
+        m_build_column_generation_task = *build_column_generation_task;
+    } else {
+        m_build_column_generation_task = ChunkColumnTaskBuilder{};
+    }
+    m_max_column_chunks = std::max(max_column_chunks, 1u);
 }
 
 bool hvox::ChunkGrid::load_chunks(
     ChunkGridPosition* chunk_positions, ui32 chunk_count
 ) {
-    bool any_chunk_failed = false;
+    std::vector<hmem::Handle<Chunk>> chunks;
+    chunks.reserve(chunk_count);
 
+    // Register every chunk before linking any, so that each chunk is linked to
+    // every neighbour being loaded with it in a single pass.
+    std::vector<hmem::Handle<Chunk>> new_chunks;
+    new_chunks.reserve(chunk_count);
     for (ui32 i = 0; i < chunk_count; ++i) {
-        any_chunk_failed = any_chunk_failed || load_chunk_at(chunk_positions[i]);
+        auto chunk = m_chunks.find(chunk_positions[i]);
+        if (chunk == nullptr) {
+            chunk = register_chunk_at(chunk_positions[i]);
+            new_chunks.emplace_back(chunk);
+        }
+        chunks.emplace_back(std::move(chunk));
     }
 
-    return any_chunk_failed;
-}
-
-bool hvox::ChunkGrid::preload_chunk_at(ChunkGridPosition chunk_position) {
-    auto it = m_chunks.find(chunk_position.id);
-    if (it != m_chunks.end()) return false;
-
-    hmem::Handle<Chunk> chunk = hmem::allocate_handle<Chunk>(m_chunk_allocator);
-    chunk->position           = chunk_position;
-    chunk->init(chunk, m_block_pager, m_instance_pager, m_navmesh_pager);
+    for (auto& chunk : new_chunks) establish_chunk_neighbours(chunk);
+
+    bool all_chunks_queued = true;
+    for (auto& chunk : chunks) {
+        // If chunk is in the process of being generated, we don't
+        // need to add it to the queue again.
+        ChunkState chunk_state = ChunkState::NONE;
+        if (!chunk->generation.compare_exchange_strong(
+                chunk_state, ChunkState::PENDING
+            ))
+        {
+            all_chunks_queued = false;
+            continue;
+        }
 
-    chunk->on_load         += &handle_chunk_load;
-    chunk->on_block_change += &handle_block_change;
+        schedule_generation(chunk);
+    }
 
-    establish_chunk_neighbours(chunk);
+    return all_chunks_queued;
+}
 
-    m_chunks[chunk_position.id] = chunk;
+bool hvox::ChunkGrid::preload_chunk_at(ChunkGridPosition chunk_position) {
+    if (m_chunks.find(chunk_position) != nullptr) return false;
 
-    m_renderer.add_chunk(chunk);
+    establish_chunk_neighbours(register_chunk_at(chunk_position));
 
     return true;
 }
@@ -170,10 +284,8 @@ bool hvox::ChunkGrid::preload_chunk_at(ChunkGridPosition chunk_position) {
 bool hvox::ChunkGrid::load_chunk_at(ChunkGridPosition chunk_position) {
     preload_chunk_at(chunk_position);
 
-    auto it = m_chunks.find(chunk_position.id);
-    if (it == m_chunks.end()) return false;
-
-    hmem::Handle<Chunk> chunk = (*it).second;
+    hmem::Handle<Chunk> chunk = m_chunks.find(chunk_position);
+    if (chunk == nullptr) return false;
 
     // If chunk is in the process of being generated, we don't
     // need to add it to the queue again.
@@ -182,9 +294,7 @@ bool hvox::ChunkGrid::load_chunk_at(ChunkGridPosition chunk_position) {
         return false;
     }
 
-    auto task = m_build_load_or_generate_task();
-    task->set_state(chunk, m_self);
-    m_thread_pool.add_task({ task, true });
+    schedule_generation(chunk);
 
     return true;
 }
@@ -192,100 +302,369 @@ bool hvox::ChunkGrid::load_chunk_at(ChunkGridPosition chunk_position) {
 bool hvox::ChunkGrid::unload_chunk_at(
     ChunkGridPosition chunk_position, hmem::WeakHandle<Chunk>* handle /*= nullptr*/
 ) {
-    auto it = m_chunks.find(chunk_position.id);
-    if (it == m_chunks.end()) return false;
+    hmem::Handle<Chunk> chunk = m_chunks.find(chunk_position);
+    if (chunk == nullptr) return false;
 
-    (*it).second->on_unload();
+    chunk->on_unload();
 
     if (handle) {
-        *handle = (*it).second;
+        *handle = chunk;
     }
 
-    // TODO(Matthew): wherever unloaded, we need to make sure we get IO right,
-    //                as chunk will "float" and something could act as if that
-    //                floating data is true even as the chunk is reloaded from
-    //                disk with a different truth.
+    // Any tasks still queued for the chunk are of no use now.
+    chunk->task_epoch.fetch_add(1, std::memory_order_acq_rel);
+
+    // Saving before the chunk leaves the registry means that if it is loaded
+    // again it is loaded as it is now.
+    save_unloaded_chunk(chunk);
+
+    unlink_chunk_neighbours(chunk);
+
+    m_chunks.erase(chunk_position);
+    m_columns.remove_chunk(chunk_position);
+    m_column_generation_cache.remove_chunk(chunk_position);
 
-    m_chunks.erase(it);
+    return true;
+}
+
+bool hvox::ChunkGrid::cancel_tasks(ChunkGridPosition chunk_position) {
+    hmem::Handle<Chunk> chunk = m_chunks.find(chunk_position);
+    if (chunk == nullptr) return false;
+
+    chunk->task_epoch.fetch_add(1, std::memory_order_acq_rel);
+
+    // Any task of the chunk's that was pending has been cancelled, and so
+    // must be able to be requested again.
+    for (auto state : { &chunk->generation, &chunk->meshing, &chunk->navmeshing }) {
+        ChunkState pending_state = ChunkState::PENDING;
+        state->compare_exchange_strong(pending_state, ChunkState::NONE);
+    }
 
     return true;
 }
 
+bool hvox::ChunkGrid::request_chunk_task(
+    hmem::Handle<Chunk> chunk, ChunkTaskKind kind
+) {
+    std::atomic<ChunkState>* state = nullptr;
+    switch (kind) {
+        case ChunkTaskKind::MESH:
+            state = &chunk->meshing;
+            break;
+        case ChunkTaskKind::NAVMESH:
+            if (!m_build_navmesh_task) return false;
+
+            state = &chunk->navmeshing;
+            break;
+        default:
+            return false;
+    }
+
+    ChunkState current_state = state->load(std::memory_order_acquire);
+    while (true) {
+        switch (current_state) {
+            case ChunkState::PENDING:
+                // Fold into the task already pending.
+                return false;
+            case ChunkState::ACTIVE:
+                // Have the running task rerun once it completes.
+                if (state->compare_exchange_weak(
+                        current_state, ChunkState::PENDING, std::memory_order_acq_rel
+                    ))
+                    return false;
+                break;
+            default:
+                if (state->compare_exchange_weak(
+                        current_state, ChunkState::PENDING, std::memory_order_acq_rel
+                    ))
+                {
+                    rerun_chunk_task(chunk, kind);
+                    return true;
+                }
+                break;
+        }
+    }
+}
+
+void hvox::ChunkGrid::request_deferred_mesh(hmem::Handle<Chunk> chunk) {
+    if (chunk->mesh_deferred.exchange(false, std::memory_order_acq_rel))
+        request_chunk_task(chunk, ChunkTaskKind::MESH);
+}
+
+void hvox::ChunkGrid::rerun_chunk_task(hmem::Handle<Chunk> chunk, ChunkTaskKind kind) {
+    ChunkTask* task = nullptr;
+    switch (kind) {
+        case ChunkTaskKind::MESH:
+            task = m_build_mesh_task();
+            break;
+        case ChunkTaskKind::NAVMESH:
+            task = m_build_navmesh_task();
+            break;
+        default:
+            return;
+    }
+
+    // The task reads the blocks of the chunk and of its neighbours across
+    // each face, and replaces what of the chunk it builds, so each of those
+    // is needed.
+    if (m_residency_manager) {
+        const ChunkDehydration built = kind == ChunkTaskKind::MESH
+                                           ? ChunkDehydration::INSTANCES
+                                           : ChunkDehydration::NAVMESH;
+        m_residency_manager->touch(
+            chunk->position,
+            static_cast<ChunkDehydration>(
+                static_cast<ui8>(built) | static_cast<ui8>(ChunkDehydration::BLOCKS)
+            )
+        );
+
+        for (ui8 face = 0; face < 6; ++face) {
+            const NeighbourOffset& offset = NEIGHBOUR_OFFSETS[face];
+
+            ChunkGridPosition neighbour_position = chunk->position;
+            neighbour_position.x                += offset.x;
+            neighbour_position.y                += offset.y;
+            neighbour_position.z                += offset.z;
+
+            m_residency_manager->touch(neighbour_position, ChunkDehydration::BLOCKS);
+        }
+    }
+
+    task->set_state(chunk, m_self);
+    m_scheduler.threadsafe_schedule(task, chunk->position, kind);
+}
+
 hmem::Handle<hvox::Chunk> hvox::ChunkGrid::chunk(ChunkID id) {
-    auto it = m_chunks.find(id);
+    return m_chunks.find(id);
+}
+
+void hvox::ChunkGrid::mark_chunk_changed(
+    hmem::WeakHandle<Chunk> handle, BlockChunkPosition start, BlockChunkPosition end
+) {
+    auto chunk = handle.lock();
+    // If chunk is nullptr, then there's no point
+    // remeshing it as we will have an unload event
+    // for this chunk.
+    if (chunk == nullptr) return;
+
+    // The chunk has been edited, so is needed whole.
+    touch_chunk(chunk->position);
+
+    ui8 faces = faces_reached(start, end);
 
-    if (it == m_chunks.end()) return nullptr;
+    std::lock_guard<std::mutex> lock(m_changed_chunks_mutex);
 
-    return it->second;
+    m_changed_chunks.try_emplace(chunk->id(), handle);
+
+    // Blocks on a face of the chunk are also meshed against by the
+    // neighbour across that face, so it too must be remeshed.
+    for (ui8 face = 0; face < 6; ++face) {
+        if (!(faces & (1 << face))) continue;
+
+        auto neighbour = chunk->neighbour(face);
+        if (neighbour) m_changed_chunks.try_emplace(neighbour->id(), neighbour);
+    }
 }
 
-void hvox::ChunkGrid::establish_chunk_neighbours(hmem::Handle<Chunk> chunk) {
-    ChunkGridPosition neighbour_position;
-
-    // Update neighbours with info of new chunk.
-    // LEFT
-    neighbour_position   = chunk->position;
-    neighbour_position.x -= 1;
-    auto it              = m_chunks.find(neighbour_position.id);
-    if (it != m_chunks.end()) {
-        chunk->neighbours.one.left         = (*it).second;
-        (*it).second->neighbours.one.right = chunk;
-    } else {
-        chunk->neighbours.one.left = hmem::WeakHandle<Chunk>();
+void hvox::ChunkGrid::schedule_changed_chunks() {
+    std::unordered_map<ChunkID, hmem::WeakHandle<Chunk>> changed_chunks;
+    {
+        std::lock_guard<std::mutex> lock(m_changed_chunks_mutex);
+        changed_chunks.swap(m_changed_chunks);
     }
 
-    // RIGHT
-    neighbour_position   = chunk->position;
-    neighbour_position.x += 1;
-    it                   = m_chunks.find(neighbour_position.id);
-    if (it != m_chunks.end()) {
-        chunk->neighbours.one.right       = (*it).second;
-        (*it).second->neighbours.one.left = chunk;
-    } else {
-        chunk->neighbours.one.right = hmem::WeakHandle<Chunk>();
+    for (auto& [id, handle] : changed_chunks) {
+        auto chunk = handle.lock();
+        if (chunk == nullptr) continue;
+
+        m_columns.update_chunk(chunk);
+
+        request_chunk_task(chunk, ChunkTaskKind::MESH);
+        request_chunk_task(chunk, ChunkTaskKind::NAVMESH);
     }
+}
 
-    // TOP
-    neighbour_position   = chunk->position;
-    neighbour_position.y += 1;
-    it                   = m_chunks.find(neighbour_position.id);
-    if (it != m_chunks.end()) {
-        chunk->neighbours.one.top           = (*it).second;
-        (*it).second->neighbours.one.bottom = chunk;
-    } else {
-        chunk->neighbours.one.top = hmem::WeakHandle<Chunk>();
+hmem::Handle<hvox::Chunk>
+hvox::ChunkGrid::register_chunk_at(ChunkGridPosition chunk_position) {
+    hmem::Handle<Chunk> chunk = hmem::allocate_handle<Chunk>(m_chunk_allocator);
+    chunk->position           = chunk_position;
+    chunk->init(
+        chunk, m_block_pager, m_instance_pager, m_navmesh_pager, m_block_storage_kind
+    );
+    chunk->column_data = m_column_generation_cache.add_chunk(chunk_position);
+
+    chunk->on_load              += &handle_chunk_load;
+    chunk->on_block_change      += &handle_block_change;
+    chunk->on_bulk_block_change += &handle_bulk_block_change;
+    chunk->on_lod_change        += &handle_lod_change;
+
+    m_chunks.insert(chunk_position, chunk);
+    m_columns.add_chunk(chunk);
+
+    m_renderer.add_chunk(chunk);
+
+    return chunk;
+}
+
+void hvox::ChunkGrid::establish_chunk_neighbours(hmem::Handle<Chunk> chunk) {
+    // Link the new chunk and each of its loaded neighbours to one another.
+    for (ui8 index = 0; index < NEIGHBOUR_COUNT; ++index) {
+        const NeighbourOffset& offset = NEIGHBOUR_OFFSETS[index];
+
+        ChunkGridPosition neighbour_position = chunk->position;
+        neighbour_position.x                += offset.x;
+        neighbour_position.y                += offset.y;
+        neighbour_position.z                += offset.z;
+
+        auto neighbour = m_chunks.find(neighbour_position);
+        if (neighbour == nullptr) continue;
+
+        const ui8 opposite = opposite_neighbour(index);
+
+        // Either chunk may be completing its generation on another thread,
+        // which it publishes under the lock on its neighbours, so the state
+        // read here is never missed by both this and its completion.
+        std::scoped_lock lock(chunk->neighbours_mutex, neighbour->neighbours_mutex);
+
+        chunk->neighbours.all[index]        = neighbour;
+        neighbour->neighbours.all[opposite] = chunk;
+
+        chunk->generated_neighbours.link(
+            index, neighbour->generation.load() == ChunkState::COMPLETE
+        );
+        neighbour->generated_neighbours.link(
+            opposite, chunk->generation.load() == ChunkState::COMPLETE
+        );
     }
+}
 
-    // BOTTOM
-    neighbour_position   = chunk->position;
-    neighbour_position.y -= 1;
-    it                   = m_chunks.find(neighbour_position.id);
-    if (it != m_chunks.end()) {
-        chunk->neighbours.one.bottom     = (*it).second;
-        (*it).second->neighbours.one.top = chunk;
-    } else {
-        chunk->neighbours.one.bottom = hmem::WeakHandle<Chunk>();
+void hvox::ChunkGrid::unlink_chunk_neighbours(hmem::Handle<Chunk> chunk) {
+    for (ui8 index = 0; index < NEIGHBOUR_COUNT; ++index) {
+        auto neighbour = chunk->neighbour(index);
+        if (neighbour == nullptr) continue;
+
+        const ui8 opposite = opposite_neighbour(index);
+
+        {
+            std::scoped_lock lock(
+                chunk->neighbours_mutex, neighbour->neighbours_mutex
+            );
+
+            neighbour->neighbours.all[opposite].reset();
+            neighbour->generated_neighbours.unlink(opposite);
+        }
+
+        // The neighbour no longer waits on the chunk to be generated.
+        request_deferred_mesh(neighbour);
     }
 
-    // FRONT
-    neighbour_position   = chunk->position;
-    neighbour_position.z += 1;
-    it                   = m_chunks.find(neighbour_position.id);
-    if (it != m_chunks.end()) {
-        chunk->neighbours.one.front       = (*it).second;
-        (*it).second->neighbours.one.back = chunk;
-    } else {
-        chunk->neighbours.one.front = hmem::WeakHandle<Chunk>();
+    std::unique_lock lock(chunk->neighbours_mutex);
+
+    chunk->neighbours = {};
+    chunk->generated_neighbours.clear();
+}
+
+bool hvox::ChunkGrid::read_saved_record(
+    ChunkGridPosition chunk_position, OUT std::vector<ui8>& record
+) {
+    if (m_save_queue && m_save_queue->read_record(chunk_position, record)) return true;
+
+    return m_region_store && m_region_store->read_record(chunk_position, record);
+}
+
+void hvox::ChunkGrid::schedule_generation(hmem::Handle<Chunk> chunk) {
+    if (m_build_column_generation_task) {
+        m_pending_generation.emplace_back(std::move(chunk));
+        return;
     }
 
-    // BACK
-    neighbour_position   = chunk->position;
-    neighbour_position.z -= 1;
-    it                   = m_chunks.find(neighbour_position.id);
-    if (it != m_chunks.end()) {
-        chunk->neighbours.one.back         = (*it).second;
-        (*it).second->neighbours.one.front = chunk;
-    } else {
-        chunk->neighbours.one.back = hmem::WeakHandle<Chunk>();
+    auto task = m_build_load_or_generate_task();
+    task->set_state(chunk, m_self);
+    m_scheduler.schedule(task, chunk->position, ChunkTaskKind::GENERATION);
+}
+
+void hvox::ChunkGrid::schedule_column_generation() {
+    if (m_pending_generation.empty()) return;
+
+    // Chunks unloaded, or whose load was cancelled, since they were held
+    // needn't be batched at all.
+    std::erase_if(m_pending_generation, [&](const hmem::Handle<Chunk>& chunk) {
+        return m_chunks.find(chunk->position) != chunk
+               || chunk->generation.load(std::memory_order_acquire)
+                      != ChunkState::PENDING;
+    });
+
+    // Sorting by column and then by height leaves the chunks stacked one on
+    // another in each column next to one another, bottom first.
+    std::sort(
+        m_pending_generation.begin(),
+        m_pending_generation.end(),
+        [](const hmem::Handle<Chunk>& lhs, const hmem::Handle<Chunk>& rhs) {
+            const ColumnID lhs_column = column_position(lhs->position).id;
+            const ColumnID rhs_column = column_position(rhs->position).id;
+            if (lhs_column != rhs_column) return lhs_column < rhs_column;
+            return lhs->position.y < rhs->position.y;
+        }
+    );
+
+    size_t run_start = 0;
+    for (size_t i = 1; i <= m_pending_generation.size(); ++i) {
+        const size_t run_length = i - run_start;
+
+        if (i < m_pending_generation.size() && run_length < m_max_column_chunks) {
+            const auto& below = m_pending_generation[i - 1]->position;
+            const auto& above = m_pending_generation[i]->position;
+            if (below.x == above.x && below.z == above.z && below.y + 1 == above.y)
+                continue;
+        }
+
+        const hmem::Handle<Chunk>* run = &m_pending_generation[run_start];
+
+        auto task = m_build_column_generation_task();
+        task->set_state(run, static_cast<ui32>(run_length), m_self);
+        // The run is prioritised as its middle chunk, such that it is
+        // loaded as soon as about half of its chunks would be.
+        m_scheduler.schedule(
+            task, run[run_length / 2]->position, ChunkTaskKind::GENERATION
+        );
+
+        run_start = i;
     }
+
+    m_pending_generation.clear();
+}
+
+bool hvox::ChunkGrid::save_unloaded_chunk(hmem::Handle<Chunk> chunk) {
+    if (m_region_store == nullptr && m_save_queue == nullptr) return false;
+
+    if (chunk->generation.load(std::memory_order_acquire) != ChunkState::COMPLETE)
+        return false;
+
+    const ui64 version = chunk->blocks.version();
+    if (version == chunk->saved_version.load(std::memory_order_acquire)) return false;
+
+    // The chunk is going away, so its blocks needn't be copied to be saved,
+    // they are released once written.
+    if (m_save_queue) {
+        auto blocks = chunk->blocks.take();
+
+        // Edits made after the blocks were taken aren't in them, but noting
+        // a block that hasn't changed costs only the space to hold it.
+        ChunkEdits edits;
+        {
+            std::unique_lock<std::shared_mutex> lock;
+            chunk->blocks.get(lock);
+
+            edits = std::move(chunk->edits);
+        }
+
+        m_save_queue->enqueue(chunk->position, std::move(blocks), std::move(edits));
+        return true;
+    }
+
+    if (!m_region_store->save_chunk(chunk)) return false;
+
+    chunk->saved_version.store(version, std::memory_order_release);
+
+    return true;
 }
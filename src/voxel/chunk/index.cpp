@@ -0,0 +1,120 @@
+#include "stdafx.h"
+
+#include "voxel/chunk/chunk.h"
+
+#include "voxel/chunk/index.h"
+
+hvox::ChunkIndex::const_iterator& hvox::ChunkIndex::const_iterator::operator++() {
+    if (m_slot < m_index->m_slots.size()) {
+        ++m_slot;
+        skip_empty_slots();
+    } else {
+        ++m_overflow;
+    }
+
+    return *this;
+}
+
+void hvox::ChunkIndex::const_iterator::skip_empty_slots() {
+    while (m_slot < m_index->m_slots.size()
+           && m_index->m_slots[m_slot].chunk == nullptr)
+        ++m_slot;
+}
+
+hvox::ChunkIndex::ChunkIndex(ui32 stride_bits /*= 0*/) :
+    m_slots(1), m_stride_bits(stride_bits), m_length_bits(0), m_size(0) {
+    // Empty.
+}
+
+void hvox::ChunkIndex::resize(ui32 min_length) {
+    ui32 length_bits = 0;
+    while ((ui32{ 1 } << length_bits) < min_length) ++length_bits;
+
+    if (length_bits == m_length_bits) return;
+
+    std::vector<ChunkIndexEntry> entries;
+    entries.reserve(m_size);
+    for (auto& entry : *this) entries.emplace_back(entry);
+
+    clear();
+
+    m_length_bits = length_bits;
+    m_slots.resize(static_cast<size_t>(1) << (3 * length_bits));
+
+    for (auto& entry : entries) {
+        ChunkGridPosition position;
+        position.id = entry.id;
+        insert(position, entry.chunk);
+    }
+}
+
+void hvox::ChunkIndex::clear() {
+    for (auto& entry : m_slots) entry = {};
+    m_overflow.clear();
+
+    m_size = 0;
+}
+
+bool hvox::ChunkIndex::insert(ChunkGridPosition position, hmem::Handle<Chunk> chunk) {
+    ChunkIndexEntry& entry = m_slots[slot_of(position)];
+
+    // NOTE(Matthew): Overflowed chunks are only ever held while their slot is
+    //                taken, so if it is free the chunk can't already be held.
+    if (entry.chunk == nullptr) {
+        entry = { position.id, chunk };
+    } else {
+        if (entry.id == position.id) return false;
+
+        if (!m_overflow.try_emplace(position.id, ChunkIndexEntry{ position.id, chunk })
+                 .second)
+            return false;
+    }
+
+    ++m_size;
+
+    return true;
+}
+
+hmem::Handle<hvox::Chunk> hvox::ChunkIndex::erase(ChunkGridPosition position) {
+    size_t           slot  = slot_of(position);
+    ChunkIndexEntry& entry = m_slots[slot];
+
+    hmem::Handle<Chunk> chunk = nullptr;
+
+    if (entry.chunk != nullptr && entry.id == position.id) {
+        chunk = std::move(entry.chunk);
+        entry = {};
+
+        // Move any chunk overflowed from this slot into it.
+        for (auto it = m_overflow.begin(); it != m_overflow.end(); ++it) {
+            ChunkGridPosition overflow_position;
+            overflow_position.id = it->first;
+
+            if (slot_of(overflow_position) == slot) {
+                entry = std::move(it->second);
+                m_overflow.erase(it);
+                break;
+            }
+        }
+    } else {
+        auto it = m_overflow.find(position.id);
+        if (it == m_overflow.end()) return nullptr;
+
+        chunk = std::move(it->second.chunk);
+        m_overflow.erase(it);
+    }
+
+    --m_size;
+
+    return chunk;
+}
+
+hvox::ChunkIndex::const_iterator hvox::ChunkIndex::begin() const {
+    const_iterator it{ this, 0, m_overflow.begin() };
+    it.skip_empty_slots();
+    return it;
+}
+
+hvox::ChunkIndex::const_iterator hvox::ChunkIndex::end() const {
+    return const_iterator{ this, m_slots.size(), m_overflow.end() };
+}
@@ -0,0 +1,204 @@
+#include "stdafx.h"
+
+#include "voxel/block_layout.hpp"
+
+#include "voxel/chunk/lod.h"
+
+// The most blocks a cell of any level of detail holds.
+static constexpr ui32 MAX_CELL_VOLUME
+    = (1u << hvox::MAX_LOD_LEVEL) * (1u << hvox::MAX_LOD_LEVEL)
+      * (1u << hvox::MAX_LOD_LEVEL);
+
+/**
+ * @brief Downsamples the cells from cell_start to cell_end inclusive, given in
+ * cells, writing them to cells in rows along x, then y, then z.
+ */
+static void downsample_cells(
+    const hvox::BlockBuffer& blocks,
+    hvox::LODLevel           lod_level,
+    ui32v3                   cell_start,
+    ui32v3                   cell_end,
+    OUT hvox::Block*         cells
+) {
+    const ui32v3 extent = cell_end - cell_start + ui32v3{ 1 };
+    const size_t count  = static_cast<size_t>(extent.x) * extent.y * extent.z;
+
+    // A uniform chunk is the same at every level of detail.
+    if (blocks.is_uniform()) {
+        std::fill_n(cells, count, blocks[0]);
+        return;
+    }
+
+    const ui32 scale       = hvox::lod_scale(lod_level);
+    const ui32 cell_volume = scale * scale * scale;
+
+    // The blocks of a cell and how many of each, few cells hold more than a
+    // handful of different blocks.
+    std::pair<hvox::Block, ui32> counts[MAX_CELL_VOLUME];
+
+    hvox::Block* cell = cells;
+    for (ui32 z = cell_start.z; z <= cell_end.z; ++z) {
+        for (ui32 y = cell_start.y; y <= cell_end.y; ++y) {
+            for (ui32 x = cell_start.x; x <= cell_end.x; ++x, ++cell) {
+                const hvox::BlockChunkPosition block_start{ x * scale,
+                                                            y * scale,
+                                                            z * scale };
+                const hvox::BlockChunkPosition block_end
+                    = block_start + hvox::BlockChunkPosition{ scale - 1 };
+
+                ui32 count_count = 0;
+                ui32 null_count  = 0;
+                hvox::for_each_block_in(
+                    block_start,
+                    block_end,
+                    [&](hvox::BlockIndex index, hvox::BlockChunkPosition) {
+                        const hvox::Block& block = blocks[index];
+                        if (block == hvox::NULL_BLOCK) {
+                            ++null_count;
+                            return;
+                        }
+
+                        for (ui32 i = 0; i < count_count; ++i) {
+                            if (counts[i].first == block) {
+                                ++counts[i].second;
+                                return;
+                            }
+                        }
+                        counts[count_count++] = { block, 1 };
+                    }
+                );
+
+                if (2 * null_count > cell_volume) {
+                    *cell = hvox::NULL_BLOCK;
+                    continue;
+                }
+
+                const auto* most_common = std::max_element(
+                    counts,
+                    counts + count_count,
+                    [](const auto& lhs, const auto& rhs) {
+                        return lhs.second < rhs.second;
+                    }
+                );
+
+                *cell = most_common->first;
+            }
+        }
+    }
+}
+
+void hvox::downsample_blocks(
+    const BlockBuffer& blocks, LODLevel lod_level, OUT Block* cells
+) {
+    const ui32 length = lod_length(lod_level);
+
+    downsample_cells(blocks, lod_level, ui32v3{ 0 }, ui32v3{ length - 1 }, cells);
+}
+
+void hvox::downsample_face(
+    const BlockBuffer& neighbour_blocks,
+    LODLevel           lod_level,
+    ChunkFace          face,
+    OUT Block*         layer
+) {
+    const ui32 last = lod_length(lod_level) - 1;
+
+    // The layer bordering the chunk is on the neighbour's opposite face.
+    ui32v3 start{ 0 }, end{ last };
+    switch (face) {
+        case ChunkFace::LEFT:
+            start.x = last;
+            break;
+        case ChunkFace::RIGHT:
+            end.x = 0;
+            break;
+        case ChunkFace::TOP:
+            end.y = 0;
+            break;
+        case ChunkFace::BOTTOM:
+            start.y = last;
+            break;
+        case ChunkFace::FRONT:
+            end.z = 0;
+            break;
+        case ChunkFace::BACK:
+            start.z = last;
+            break;
+    }
+
+    downsample_cells(neighbour_blocks, lod_level, start, end, layer);
+}
+
+void hvox::mesh_cells(
+    const Block*       cells,
+    const Block*       layers[6],
+    LODLevel           lod_level,
+    ChunkGridPosition  chunk_position,
+    OUT ChunkInstance& instance
+) {
+    const ui32  length = lod_length(lod_level);
+    const f32   scale  = static_cast<f32>(lod_scale(lod_level));
+    const f32v3 origin = f32v3(block_world_position(chunk_position));
+
+    auto cell_at = [&](ui32 x, ui32 y, ui32 z) {
+        return cells[x + (y + z * length) * length];
+    };
+
+    // Whether the cell of the neighbour across the given face at the given
+    // index into its layer is empty. Without a neighbour, nothing is seen
+    // across the face.
+    auto empty_across = [&](ChunkFace face, ui32 index) {
+        const Block* layer = layers[static_cast<ui8>(face)];
+        return layer != nullptr && layer[index] == NULL_BLOCK;
+    };
+
+    auto is_exposed = [&](ui32 x, ui32 y, ui32 z) {
+        if (x == 0 ? empty_across(ChunkFace::LEFT, y + z * length)
+                   : cell_at(x - 1, y, z) == NULL_BLOCK)
+            return true;
+        if (x == length - 1 ? empty_across(ChunkFace::RIGHT, y + z * length)
+                            : cell_at(x + 1, y, z) == NULL_BLOCK)
+            return true;
+        if (y == length - 1 ? empty_across(ChunkFace::TOP, x + z * length)
+                            : cell_at(x, y + 1, z) == NULL_BLOCK)
+            return true;
+        if (y == 0 ? empty_across(ChunkFace::BOTTOM, x + z * length)
+                   : cell_at(x, y - 1, z) == NULL_BLOCK)
+            return true;
+        if (z == length - 1 ? empty_across(ChunkFace::FRONT, x + y * length)
+                            : cell_at(x, y, z + 1) == NULL_BLOCK)
+            return true;
+        return z == 0 ? empty_across(ChunkFace::BACK, x + y * length)
+                      : cell_at(x, y, z - 1) == NULL_BLOCK;
+    };
+
+    instance.count = 0;
+
+    for (ui32 z = 0; z < length; ++z) {
+        for (ui32 y = 0; y < length; ++y) {
+            ui32 run_start  = 0;
+            ui32 run_length = 0;
+
+            auto end_run = [&]() {
+                if (run_length == 0) return;
+
+                instance.data[instance.count++] = {
+                    origin + f32v3{ run_start, y, z } * scale,
+                    f32v3{ run_length, 1, 1 } * scale
+                };
+                run_length = 0;
+            };
+
+            for (ui32 x = 0; x < length; ++x) {
+                if (cell_at(x, y, z) == NULL_BLOCK || !is_exposed(x, y, z)) {
+                    end_run();
+                    continue;
+                }
+
+                if (run_length == 0) run_start = x;
+                ++run_length;
+            }
+            end_run();
+        }
+    }
+}
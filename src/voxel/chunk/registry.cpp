@@ -0,0 +1,78 @@
+#include "stdafx.h"
+
+#include "voxel/chunk/chunk.h"
+
+#include "voxel/chunk/registry.h"
+
+hvox::ChunkRegistry::const_iterator&
+hvox::ChunkRegistry::const_iterator::operator++() {
+    if (++m_entry == m_registry->m_shards[m_shard].index.end()) {
+        ++m_shard;
+        skip_empty_shards();
+    }
+
+    return *this;
+}
+
+void hvox::ChunkRegistry::const_iterator::skip_empty_shards() {
+    while (m_shard < SHARD_COUNT && m_registry->m_shards[m_shard].index.empty())
+        ++m_shard;
+
+    if (m_shard < SHARD_COUNT) m_entry = m_registry->m_shards[m_shard].index.begin();
+}
+
+void hvox::ChunkRegistry::resize(ui32 min_length) {
+    // Each shard holds every other chunk along each axis.
+    ui32 shard_length = (min_length + (1 << SHARD_BITS) - 1) >> SHARD_BITS;
+
+    for (auto& shard : m_shards) {
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        shard.index.resize(shard_length);
+    }
+}
+
+void hvox::ChunkRegistry::clear() {
+    for (auto& shard : m_shards) {
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        shard.index.clear();
+    }
+
+    m_size.store(0, std::memory_order_relaxed);
+}
+
+bool hvox::ChunkRegistry::insert(
+    ChunkGridPosition position, hmem::Handle<Chunk> chunk
+) {
+    Shard& shard = m_shards[shard_of(position)];
+
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    if (!shard.index.insert(position, chunk)) return false;
+
+    m_size.fetch_add(1, std::memory_order_relaxed);
+
+    return true;
+}
+
+hmem::Handle<hvox::Chunk> hvox::ChunkRegistry::erase(ChunkGridPosition position) {
+    Shard& shard = m_shards[shard_of(position)];
+
+    hmem::Handle<Chunk> chunk;
+    {
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        chunk = shard.index.erase(position);
+    }
+
+    if (chunk != nullptr) m_size.fetch_sub(1, std::memory_order_relaxed);
+
+    return chunk;
+}
+
+hvox::ChunkRegistry::const_iterator hvox::ChunkRegistry::begin() const {
+    const_iterator it{ this, 0 };
+    it.skip_empty_shards();
+    return it;
+}
+
+hvox::ChunkRegistry::const_iterator hvox::ChunkRegistry::end() const {
+    return const_iterator{ this, SHARD_COUNT };
+}
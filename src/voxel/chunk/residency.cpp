@@ -0,0 +1,259 @@
+#include "stdafx.h"
+
+#include "voxel/chunk/grid.h"
+
+#include "voxel/chunk/residency.h"
+
+static bool has_step(ui8 dehydration, hvox::ChunkDehydration step) {
+    return (dehydration & static_cast<ui8>(step)) != 0;
+}
+
+hvox::ChunkResidencyManager::ChunkResidencyManager() :
+    m_budget(0),
+    m_active_distance(0),
+    m_max_dehydrations(0),
+    m_tick(0),
+    m_usage{ 0, 0, 0, 0 } {
+    // Empty.
+}
+
+void hvox::ChunkResidencyManager::init(
+    hmem::WeakHandle<ChunkGrid> chunk_grid,
+    size_t                      budget,
+    ui32                        active_distance /*= 2*/,
+    ui32                        max_dehydrations /*= 64*/
+) {
+    m_chunk_grid       = chunk_grid;
+    m_budget           = budget;
+    m_active_distance  = active_distance;
+    m_max_dehydrations = max_dehydrations;
+}
+
+void hvox::ChunkResidencyManager::dispose() {
+    m_chunk_grid = {};
+
+    std::vector<ChunkGridPosition>().swap(m_focus_points);
+    std::unordered_map<ChunkID, ChunkResidency>().swap(m_residencies);
+    std::vector<std::pair<ui64, ChunkID>>().swap(m_candidates);
+
+    std::lock_guard lock(m_touched_mutex);
+    std::vector<std::pair<ChunkGridPosition, ui8>>().swap(m_touched);
+    std::vector<std::pair<ChunkGridPosition, ui8>>().swap(m_touched_buffer);
+}
+
+void hvox::ChunkResidencyManager::set_focus_points(
+    const ChunkGridPosition* focus_points, ui32 focus_point_count
+) {
+    m_focus_points.assign(focus_points, focus_points + focus_point_count);
+}
+
+void hvox::ChunkResidencyManager::touch(
+    ChunkGridPosition chunk_position, ChunkDehydration needs /*= ChunkDehydration::ALL*/
+) {
+    std::lock_guard lock(m_touched_mutex);
+
+    m_touched.emplace_back(chunk_position, static_cast<ui8>(needs));
+}
+
+void hvox::ChunkResidencyManager::update() {
+    auto chunk_grid = m_chunk_grid.lock();
+    if (chunk_grid == nullptr) return;
+
+    ++m_tick;
+
+    update_usage(chunk_grid);
+
+    need_touched(chunk_grid);
+
+    const i64 active_distance = static_cast<i64>(m_active_distance);
+    for (auto& focus_point : m_focus_points) {
+        for (i64 z = -active_distance; z <= active_distance; ++z) {
+            for (i64 y = -active_distance; y <= active_distance; ++y) {
+                for (i64 x = -active_distance; x <= active_distance; ++x) {
+                    ChunkGridPosition position = focus_point;
+                    position.x                += x;
+                    position.y                += y;
+                    position.z                += z;
+
+                    auto it = m_residencies.find(position.id);
+                    if (it == m_residencies.end()) continue;
+
+                    auto chunk = chunk_grid->chunk(position);
+                    if (chunk) need(chunk_grid, chunk, it->second);
+                }
+            }
+        }
+    }
+
+    size_t used = m_usage.total();
+    if (used <= m_budget) return;
+
+    // Chunks needed in this update are left alone, the rest are dehydrated
+    // least recently needed first.
+    m_candidates.clear();
+    for (auto& [id, residency] : m_residencies) {
+        if (residency.last_needed < m_tick)
+            m_candidates.emplace_back(residency.last_needed, id);
+    }
+    std::sort(m_candidates.begin(), m_candidates.end());
+
+    // Every candidate gives up what is cheapest to rebuild before any gives
+    // up anything dearer.
+    ui32 dehydrations = 0;
+    for (auto step : { ChunkDehydration::NAVMESH,
+                       ChunkDehydration::INSTANCES,
+                       ChunkDehydration::BLOCKS })
+    {
+        for (auto& [last_needed, id] : m_candidates) {
+            if (used <= m_budget || dehydrations >= m_max_dehydrations) return;
+
+            ChunkResidency& residency = m_residencies[id];
+            if (has_step(residency.dehydration, step)) continue;
+
+            auto chunk = chunk_grid->chunk(id);
+            if (chunk == nullptr) continue;
+
+            const ui8 dehydration = residency.dehydration;
+
+            used -= std::min(used, dehydrate(chunk, residency, step));
+
+            if (residency.dehydration != dehydration) ++dehydrations;
+        }
+    }
+}
+
+size_t hvox::ChunkResidencyManager::dehydrated_count() const {
+    return static_cast<size_t>(std::count_if(
+        m_residencies.begin(),
+        m_residencies.end(),
+        [](const auto& entry) { return entry.second.dehydration != 0; }
+    ));
+}
+
+void hvox::ChunkResidencyManager::need(
+    hmem::Handle<ChunkGrid> chunk_grid,
+    hmem::Handle<Chunk>     chunk,
+    ChunkResidency&         residency,
+    ui8                     needs /*= static_cast<ui8>(ChunkDehydration::ALL)*/
+) {
+    residency.last_needed = m_tick;
+
+    const ui8 rehydration = residency.dehydration & needs;
+    if (rehydration == 0) return;
+
+    // Clear the steps first, as the tasks requested below touch the chunk
+    // again.
+    residency.dehydration &= ~rehydration;
+
+    if (has_step(rehydration, ChunkDehydration::BLOCKS)) chunk->blocks.decompress();
+
+    if (has_step(rehydration, ChunkDehydration::INSTANCES)) {
+        chunk->dirty.mesh.mark_all();
+        chunk_grid->request_chunk_task(chunk, ChunkTaskKind::MESH);
+    }
+
+    if (has_step(rehydration, ChunkDehydration::NAVMESH)) {
+        chunk->dirty.navmesh.mark_all();
+        chunk_grid->request_chunk_task(chunk, ChunkTaskKind::NAVMESH);
+    }
+}
+
+void hvox::ChunkResidencyManager::need_touched(hmem::Handle<ChunkGrid> chunk_grid) {
+    // Swap out the touched chunks, as needing them may touch more, which are
+    // then left for the next update.
+    {
+        std::lock_guard lock(m_touched_mutex);
+
+        m_touched_buffer.clear();
+        std::swap(m_touched, m_touched_buffer);
+    }
+
+    for (auto& [position, needs] : m_touched_buffer) {
+        // Chunks not yet seen by an update are yet to be dehydrated.
+        auto it = m_residencies.find(position.id);
+        if (it == m_residencies.end()) continue;
+
+        auto chunk = chunk_grid->chunk(position);
+        if (chunk) need(chunk_grid, chunk, it->second, needs);
+    }
+}
+
+size_t hvox::ChunkResidencyManager::dehydrate(
+    hmem::Handle<Chunk> chunk, ChunkResidency& residency, ChunkDehydration step
+) {
+    switch (step) {
+        case ChunkDehydration::NAVMESH:
+        {
+            // Only a navmesh that is complete, and not about to be rebuilt,
+            // may be dropped; clearing the state means it is rebuilt whole
+            // once requested again.
+            ChunkState complete_state = ChunkState::COMPLETE;
+            if (!chunk->navmeshing.compare_exchange_strong(
+                    complete_state, ChunkState::NONE, std::memory_order_acq_rel
+                ))
+                return 0;
+
+            const size_t bytes = chunk->navmesh.allocated_bytes();
+            chunk->navmesh.clear();
+
+            residency.dehydration |= static_cast<ui8>(step);
+            return bytes - std::min(bytes, chunk->navmesh.allocated_bytes());
+        }
+        case ChunkDehydration::INSTANCES:
+        {
+            // Instance data already handed to the renderer has been freed.
+            const size_t bytes = chunk->instance.allocated_bytes();
+            if (bytes == 0) return 0;
+
+            ChunkState complete_state = ChunkState::COMPLETE;
+            if (!chunk->meshing.compare_exchange_strong(
+                    complete_state, ChunkState::NONE, std::memory_order_acq_rel
+                ))
+                return 0;
+
+            chunk->instance.free_buffer();
+
+            residency.dehydration |= static_cast<ui8>(step);
+            return bytes;
+        }
+        case ChunkDehydration::BLOCKS:
+        {
+            if (chunk->generation.load(std::memory_order_acquire)
+                != ChunkState::COMPLETE)
+                return 0;
+
+            const size_t bytes = chunk->blocks.allocated_bytes();
+            if (bytes == 0) return 0;
+
+            // Even if the blocks don't compress, they are as small as they
+            // get, so we don't try again until the chunk is next needed. The
+            // snapshot readers hold of them is no longer shared, so goes once
+            // they are done, but is not counted as freed until it has.
+            residency.dehydration |= static_cast<ui8>(step);
+            if (!chunk->blocks.compress()) return 0;
+
+            return bytes - std::min(bytes, chunk->blocks.allocated_bytes());
+        }
+        default:
+            return 0;
+    }
+}
+
+void hvox::ChunkResidencyManager::update_usage(hmem::Handle<ChunkGrid> chunk_grid) {
+    m_usage = { 0, 0, 0, 0 };
+
+    // Chunks are first needed when first seen.
+    for (auto& [id, chunk] : chunk_grid->chunks()) {
+        auto [it, _] = m_residencies.try_emplace(id, ChunkResidency{ m_tick, 0, 0 });
+        it->second.last_seen = m_tick;
+
+        m_usage.blocks    += chunk->blocks.allocated_bytes();
+        m_usage.snapshots += chunk->blocks.snapshot_bytes();
+        m_usage.instances += chunk->instance.allocated_bytes();
+        m_usage.navmeshes += chunk->navmesh.allocated_bytes();
+    }
+
+    std::erase_if(m_residencies, [&](const auto& entry) {
+        return entry.second.last_seen != m_tick;
+    });
+}
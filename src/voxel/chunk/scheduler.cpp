@@ -0,0 +1,157 @@
+#include "stdafx.h"
+
+#include "voxel/chunk/scheduler.h"
+
+hvox::ChunkTaskScheduler::ChunkTaskScheduler() :
+    m_thread_pool(nullptr),
+    m_queue_depth(0),
+    m_focus_changed(false),
+    m_next_order(0) {
+    // Empty.
+}
+
+void hvox::ChunkTaskScheduler::init(
+    thread::ThreadPool<ChunkTaskContext>* thread_pool, ui32 queue_depth
+) {
+    m_thread_pool = thread_pool;
+    m_queue_depth = queue_depth;
+}
+
+void hvox::ChunkTaskScheduler::dispose() {
+    {
+        std::lock_guard<std::mutex> lock(m_incoming_tasks_mutex);
+        m_tasks.insert(m_tasks.end(), m_incoming_tasks.begin(), m_incoming_tasks.end());
+        std::vector<ScheduledTask>().swap(m_incoming_tasks);
+    }
+
+    for (auto& scheduled : m_tasks) {
+        scheduled.task->dispose();
+        delete scheduled.task;
+    }
+
+    std::vector<ScheduledTask>().swap(m_tasks);
+    std::vector<ChunkGridPosition>().swap(m_focus_points);
+    std::vector<thread::HeldTask<ChunkTaskContext>>().swap(m_dispatch_buffer);
+
+    m_thread_pool = nullptr;
+}
+
+void hvox::ChunkTaskScheduler::set_focus_points(
+    const ChunkGridPosition* focus_points, ui32 focus_point_count
+) {
+    // Focus points rarely move from one chunk to the next, and only then do
+    // priorities need recalculating.
+    if (focus_point_count == m_focus_points.size()
+        && std::equal(
+            focus_points,
+            focus_points + focus_point_count,
+            m_focus_points.begin(),
+            [](ChunkGridPosition lhs, ChunkGridPosition rhs) {
+                return lhs.id == rhs.id;
+            }
+        ))
+        return;
+
+    m_focus_points.assign(focus_points, focus_points + focus_point_count);
+    m_focus_changed = true;
+}
+
+void hvox::ChunkTaskScheduler::schedule(
+    ChunkTask* task, ChunkGridPosition position, ChunkTaskKind kind
+) {
+    m_tasks.push_back(
+        { priority_of(position, kind), m_next_order++, task, position, kind }
+    );
+    std::push_heap(m_tasks.begin(), m_tasks.end(), LessUrgent{});
+}
+
+void hvox::ChunkTaskScheduler::threadsafe_schedule(
+    ChunkTask* task, ChunkGridPosition position, ChunkTaskKind kind
+) {
+    std::lock_guard<std::mutex> lock(m_incoming_tasks_mutex);
+
+    // Priority and order are given when the task is moved onto the heap.
+    m_incoming_tasks.push_back({ 0, 0, task, position, kind });
+}
+
+void hvox::ChunkTaskScheduler::dispatch() {
+    if (m_thread_pool == nullptr) return;
+
+    update_heap();
+
+    size_t queued_count = m_thread_pool->approx_num_tasks();
+    if (queued_count >= m_queue_depth) return;
+
+    size_t dispatch_count = m_queue_depth - queued_count;
+
+    m_dispatch_buffer.clear();
+    while (m_dispatch_buffer.size() < dispatch_count && !m_tasks.empty()) {
+        std::pop_heap(m_tasks.begin(), m_tasks.end(), LessUrgent{});
+        ChunkTask* task = m_tasks.back().task;
+        m_tasks.pop_back();
+
+        // Cancelled tasks would only be dropped by the thread pool, so
+        // there's no sense in handing them over.
+        if (task->is_cancelled()) {
+            task->dispose();
+            delete task;
+            continue;
+        }
+
+        m_dispatch_buffer.push_back({ task, true });
+    }
+
+    if (m_dispatch_buffer.empty()) return;
+
+    m_thread_pool->add_tasks(m_dispatch_buffer.data(), m_dispatch_buffer.size());
+}
+
+ui64 hvox::ChunkTaskScheduler::priority_of(
+    ChunkGridPosition position, ChunkTaskKind kind
+) const {
+    ui64 distance = 0;
+    if (!m_focus_points.empty()) {
+        distance = std::numeric_limits<ui64>::max();
+        for (auto& focus_point : m_focus_points) {
+            i64 dx = static_cast<i64>(position.x) - static_cast<i64>(focus_point.x);
+            i64 dy = static_cast<i64>(position.y) - static_cast<i64>(focus_point.y);
+            i64 dz = static_cast<i64>(position.z) - static_cast<i64>(focus_point.z);
+
+            distance = std::min(
+                distance, static_cast<ui64>(dx * dx) + static_cast<ui64>(dy * dy)
+                              + static_cast<ui64>(dz * dz)
+            );
+        }
+    }
+
+    // The squared distance fits comfortably in 56 bits given the widths of
+    // chunk grid coordinates, leaving the lowest 8 bits for the kind.
+    return (distance << 8) | static_cast<ui64>(kind);
+}
+
+void hvox::ChunkTaskScheduler::update_heap() {
+    {
+        std::lock_guard<std::mutex> lock(m_incoming_tasks_mutex);
+
+        for (auto& scheduled : m_incoming_tasks) {
+            scheduled.priority = priority_of(scheduled.position, scheduled.kind);
+            scheduled.order    = m_next_order++;
+
+            m_tasks.push_back(scheduled);
+            if (!m_focus_changed)
+                std::push_heap(m_tasks.begin(), m_tasks.end(), LessUrgent{});
+        }
+        m_incoming_tasks.clear();
+    }
+
+    if (!m_focus_changed) return;
+
+    // Recalculating each priority and rebuilding the heap in one pass is
+    // linear in the number of held tasks.
+    for (auto& scheduled : m_tasks)
+        scheduled.priority = priority_of(scheduled.position, scheduled.kind);
+
+    std::make_heap(m_tasks.begin(), m_tasks.end(), LessUrgent{});
+
+    m_focus_changed = false;
+}
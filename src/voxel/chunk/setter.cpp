@@ -11,7 +11,7 @@ bool hvox::set_block(
 
     {
         std::shared_lock<std::shared_mutex> lock;
-        auto                                blocks = chunk->blocks.get(lock);
+        auto&                               blocks = chunk->blocks.get(lock);
 
         bool gen_task_active
             = chunk->generation.load(std::memory_order_acquire) == ChunkState::ACTIVE;
@@ -23,9 +23,11 @@ bool hvox::set_block(
     }
 
     std::unique_lock<std::shared_mutex> lock;
-    auto                                blocks = chunk->blocks.get(lock);
+    auto&                               blocks = chunk->blocks.get(lock);
 
-    blocks[block_idx] = block;
+    blocks.set(block_idx, block);
+
+    chunk->mark_dirty(position, position);
 
     return true;
 }
@@ -47,9 +49,11 @@ bool hvox::set_blocks(
     }
 
     std::unique_lock<std::shared_mutex> lock;
-    auto                                chunk_blocks = chunk->blocks.get(lock);
+    auto&                               chunk_blocks = chunk->blocks.get(lock);
+
+    chunk_blocks.fill(start, end, block);
 
-    set_per_block_data(chunk_blocks, start, end, block);
+    chunk->mark_dirty(start, end);
 
     return true;
 }
@@ -60,20 +64,26 @@ bool hvox::set_blocks(
     BlockChunkPosition  end,
     Block*              blocks
 ) {
+    // The end of the buffer is exclusive, while that of the change event, as
+    // of dirty regions, is inclusive.
+    const BlockChunkPosition last = end - BlockChunkPosition{ 1 };
+
     {
         bool gen_task_active
             = chunk->generation.load(std::memory_order_acquire) == ChunkState::ACTIVE;
         if (!gen_task_active) {
             bool should_cancel
-                = chunk->on_bulk_block_change({ blocks, false, start, end });
+                = chunk->on_bulk_block_change({ blocks, false, start, last });
             if (should_cancel) return false;
         }
     }
 
     std::unique_lock<std::shared_mutex> lock;
-    auto                                chunk_blocks = chunk->blocks.get(lock);
+    auto&                               chunk_blocks = chunk->blocks.get(lock);
+
+    chunk_blocks.copy(start, end, blocks);
 
-    set_per_block_data(chunk_blocks, start, end, blocks);
+    chunk->mark_dirty(start, last);
 
     return true;
 }
@@ -0,0 +1,188 @@
+#include "stdafx.h"
+
+#include "voxel/chunk/grid.h"
+
+#include "voxel/chunk/streamer.h"
+
+hvox::ChunkStreamer::ChunkStreamer() :
+    m_budget{ 0, 0, 0 },
+    m_hysteresis(0),
+    m_focus_changed(false),
+    m_render_distance(0) {
+    // Empty.
+}
+
+void hvox::ChunkStreamer::init(
+    hmem::WeakHandle<ChunkGrid> chunk_grid,
+    ChunkStreamingBudget        budget /*= { 256, 128, 128 }*/,
+    ui32                        hysteresis /*= 1*/
+) {
+    m_chunk_grid = chunk_grid;
+    m_budget     = budget;
+    m_hysteresis = hysteresis;
+}
+
+void hvox::ChunkStreamer::dispose() {
+    m_chunk_grid = {};
+
+    std::vector<ChunkGridPosition>().swap(m_focus_points);
+    std::unordered_set<ChunkID>().swap(m_streamed_chunks);
+    std::unordered_set<ChunkID>().swap(m_unloading_preloads);
+    std::deque<ChunkGridPosition>().swap(m_preload_queue);
+    std::deque<ChunkGridPosition>().swap(m_load_queue);
+    std::vector<ChunkGridPosition>().swap(m_unload_queue);
+    std::vector<ChunkGridPosition>().swap(m_load_buffer);
+}
+
+void hvox::ChunkStreamer::set_focus_points(
+    const ChunkGridPosition* focus_points, ui32 focus_point_count
+) {
+    auto chunk_grid = m_chunk_grid.lock();
+    if (chunk_grid) chunk_grid->set_focus_points(focus_points, focus_point_count);
+
+    if (focus_point_count == m_focus_points.size()
+        && std::equal(
+            focus_points,
+            focus_points + focus_point_count,
+            m_focus_points.begin(),
+            [](ChunkGridPosition lhs, ChunkGridPosition rhs) {
+                return lhs.id == rhs.id;
+            }
+        ))
+        return;
+
+    m_focus_points.assign(focus_points, focus_points + focus_point_count);
+    m_focus_changed = true;
+}
+
+void hvox::ChunkStreamer::update() {
+    auto chunk_grid = m_chunk_grid.lock();
+    if (chunk_grid == nullptr) return;
+
+    if (m_focus_changed || m_render_distance != chunk_grid->render_distance()) {
+        m_render_distance = chunk_grid->render_distance();
+        m_focus_changed   = false;
+
+        update_queues();
+    }
+
+    // Unload first, so that the memory of chunks left behind may be reused by
+    // those we are about to load.
+    for (ui32 i = 0; i < m_budget.unloads && !m_unload_queue.empty(); ++i) {
+        chunk_grid->unload_chunk_at(m_unload_queue.back());
+        m_unloading_preloads.erase(m_unload_queue.back().id);
+        m_unload_queue.pop_back();
+    }
+
+    // Preloading ahead of loading means chunks are mostly linked to their
+    // neighbours by the time they are generated.
+    for (ui32 i = 0; i < m_budget.preloads && !m_preload_queue.empty(); ++i) {
+        chunk_grid->preload_chunk_at(m_preload_queue.front());
+        m_load_queue.push_back(m_preload_queue.front());
+        m_preload_queue.pop_front();
+    }
+
+    m_load_buffer.clear();
+    for (ui32 i = 0; i < m_budget.loads && !m_load_queue.empty(); ++i) {
+        m_load_buffer.push_back(m_load_queue.front());
+        m_load_queue.pop_front();
+    }
+
+    if (!m_load_buffer.empty())
+        chunk_grid->load_chunks(
+            m_load_buffer.data(), static_cast<ui32>(m_load_buffer.size())
+        );
+}
+
+i64 hvox::ChunkStreamer::distance_to_focus(ChunkGridPosition position) const {
+    i64 distance = std::numeric_limits<i64>::max();
+    for (auto& focus_point : m_focus_points) {
+        i64 dx = std::abs(static_cast<i64>(position.x - focus_point.x));
+        i64 dy = std::abs(static_cast<i64>(position.y - focus_point.y));
+        i64 dz = std::abs(static_cast<i64>(position.z - focus_point.z));
+
+        distance = std::min(distance, std::max({ dx, dy, dz }));
+    }
+    return distance;
+}
+
+void hvox::ChunkStreamer::update_queues() {
+    const i64 load_distance   = static_cast<i64>(m_render_distance / 2);
+    const i64 unload_distance = load_distance + static_cast<i64>(m_hysteresis);
+
+    // Chunks yet to be loaded that are now out of range can simply be
+    // forgotten, though those already preloaded must be unloaded.
+    auto out_of_range = [&](ChunkGridPosition position) {
+        return distance_to_focus(position) > unload_distance;
+    };
+
+    auto forget = [&](ChunkGridPosition position) {
+        m_streamed_chunks.erase(position.id);
+        return true;
+    };
+
+    std::erase_if(m_preload_queue, [&](ChunkGridPosition position) {
+        return out_of_range(position) && forget(position);
+    });
+    std::erase_if(m_load_queue, [&](ChunkGridPosition position) {
+        if (!out_of_range(position)) return false;
+
+        m_unload_queue.push_back(position);
+        m_unloading_preloads.insert(position.id);
+        return forget(position);
+    });
+
+    // Note every loaded chunk now out of range for unloading, leaving alone
+    // any between the load and unload distances.
+    std::unordered_set<ChunkID> queued_unloads;
+    for (auto& position : m_unload_queue) queued_unloads.insert(position.id);
+
+    for (auto it = m_streamed_chunks.begin(); it != m_streamed_chunks.end();) {
+        ChunkGridPosition position;
+        position.id = *it;
+
+        if (out_of_range(position)) {
+            if (queued_unloads.insert(position.id).second)
+                m_unload_queue.push_back(position);
+            it = m_streamed_chunks.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    // Chunks that came back into range before being unloaded are kept, and
+    // those that were never loaded are queued to be once more.
+    std::erase_if(m_unload_queue, [&](ChunkGridPosition position) {
+        if (distance_to_focus(position) > load_distance) return false;
+
+        m_streamed_chunks.insert(position.id);
+        if (m_unloading_preloads.erase(position.id)) m_load_queue.push_back(position);
+        return true;
+    });
+
+    // Queue every chunk in range not yet streamed for preloading.
+    for (auto& focus_point : m_focus_points) {
+        for (i64 z = -load_distance; z <= load_distance; ++z) {
+            for (i64 y = -load_distance; y <= load_distance; ++y) {
+                for (i64 x = -load_distance; x <= load_distance; ++x) {
+                    ChunkGridPosition position = focus_point;
+                    position.x                += x;
+                    position.y                += y;
+                    position.z                += z;
+
+                    if (!m_streamed_chunks.insert(position.id).second) continue;
+
+                    m_preload_queue.push_back(position);
+                }
+            }
+        }
+    }
+
+    // Nearest chunks are loaded first, and furthest chunks unloaded first.
+    auto nearer = [&](ChunkGridPosition lhs, ChunkGridPosition rhs) {
+        return distance_to_focus(lhs) < distance_to_focus(rhs);
+    };
+    std::stable_sort(m_preload_queue.begin(), m_preload_queue.end(), nearer);
+    std::stable_sort(m_load_queue.begin(), m_load_queue.end(), nearer);
+    std::stable_sort(m_unload_queue.begin(), m_unload_queue.end(), nearer);
+}
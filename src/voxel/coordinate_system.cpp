@@ -1,13 +1,12 @@
 #include "stdafx.h"
 
+#include "voxel/block_layout.hpp"
 #include "voxel/chunk/chunk.h"
 
 #include "voxel/coordinate_system.h"
 
 ui32 hvox::block_index(BlockChunkPosition block_chunk_position) {
-    return static_cast<ui32>(block_chunk_position.x)
-           + static_cast<ui32>(block_chunk_position.y) * CHUNK_LENGTH
-           + static_cast<ui32>(block_chunk_position.z) * CHUNK_AREA;
+    return layout_block_index(block_chunk_position);
 }
 
 hvox::BlockChunkPosition
@@ -24,20 +23,7 @@ hvox::block_chunk_position(BlockWorldPosition block_world_position) {
 }
 
 hvox::BlockChunkPosition hvox::block_chunk_position(ui32 index) {
-    BlockChunkPositionCoord z = static_cast<BlockChunkPositionCoord>(
-        static_cast<f32>(index) / static_cast<f32>(CHUNK_AREA)
-    );
-
-    index %= CHUNK_AREA;
-
-    BlockChunkPositionCoord y = static_cast<BlockChunkPositionCoord>(
-        static_cast<f32>(index) / static_cast<f32>(CHUNK_LENGTH)
-    );
-
-    BlockChunkPositionCoord x
-        = static_cast<BlockChunkPositionCoord>(index % CHUNK_LENGTH);
-
-    return { x, y, z };
+    return layout_block_chunk_position(index);
 }
 
 hvox::BlockWorldPosition hvox::block_world_position(f32v3 position) {
@@ -80,6 +66,13 @@ static_cast<f32>(block_world_position.x) / static_cast<f32>(CHUNK_LENGTH)
     };
 }
 
+hvox::ColumnWorldPosition hvox::column_position(ChunkGridPosition chunk_grid_position) {
+    ColumnWorldPosition column_position;
+    column_position.x = static_cast<i32>(chunk_grid_position.x);
+    column_position.z = static_cast<i32>(chunk_grid_position.z);
+    return column_position;
+}
+
 bool operator==(hvox::ColumnWorldPosition lhs, hvox::ColumnWorldPosition rhs) {
     return lhs.id == rhs.id;
 }
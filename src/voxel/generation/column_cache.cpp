@@ -0,0 +1,29 @@
+#include "stdafx.h"
+
+#include "voxel/generation/column_cache.h"
+
+void hvox::ColumnGenerationCache::dispose() {
+    std::unordered_map<ColumnID, CachedColumn>().swap(m_columns);
+}
+
+hmem::Handle<hvox::ColumnGenerationData>
+hvox::ColumnGenerationCache::add_chunk(ChunkGridPosition chunk_position) {
+    const ColumnWorldPosition column = column_position(chunk_position);
+
+    auto [it, inserted] = m_columns.try_emplace(column.id);
+    if (inserted) {
+        it->second.data        = hmem::make_handle<ColumnGenerationData>(column);
+        it->second.chunk_count = 0;
+    }
+
+    ++it->second.chunk_count;
+
+    return it->second.data;
+}
+
+void hvox::ColumnGenerationCache::remove_chunk(ChunkGridPosition chunk_position) {
+    auto it = m_columns.find(column_position(chunk_position).id);
+    if (it == m_columns.end()) return;
+
+    if (--it->second.chunk_count == 0) m_columns.erase(it);
+}
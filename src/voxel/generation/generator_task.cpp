@@ -0,0 +1,57 @@
+#include "stdafx.h"
+
+#include "voxel/chunk/grid.h"
+
+#include "voxel/generation/generator_task.hpp"
+
+bool hvox::begin_generation(
+    hmem::Handle<Chunk>         chunk,
+    hmem::WeakHandle<ChunkGrid> chunk_grid,
+    OUT std::vector<ui8>&       delta
+) {
+    delta.clear();
+
+    // Chunks saved since they were last generated are loaded as they were
+    // saved, only those never saved are generated. Those saved as a delta
+    // are generated and then have their edits applied anew.
+    std::vector<ui8> record;
+    bool             saved = false;
+    if (auto locked_chunk_grid = chunk_grid.lock())
+        saved = locked_chunk_grid->read_saved_record(chunk->position, record);
+
+    const bool is_delta = saved && is_delta_record(record.data(), record.size());
+
+    bool loaded = false;
+    {
+        std::unique_lock<std::shared_mutex> lock;
+        BlockBuffer&                        blocks = chunk->blocks.get(lock);
+
+        chunk->edits.reset();
+
+        if (saved && !is_delta)
+            loaded = decode_chunk_record(
+                record.data(), record.size(), blocks, chunk->edits
+            );
+    }
+
+    if (is_delta) delta = std::move(record);
+
+    return !loaded;
+}
+
+void hvox::end_generation(hmem::Handle<Chunk> chunk, const std::vector<ui8>& delta) {
+    if (!delta.empty()) {
+        std::unique_lock<std::shared_mutex> lock;
+        BlockBuffer&                        blocks = chunk->blocks.get(lock);
+
+        if (!decode_chunk_record(delta.data(), delta.size(), blocks, chunk->edits))
+            debug_printf(
+                "Failed to apply saved edits of chunk at (%d, %d, %d).\n",
+                static_cast<i32>(chunk->position.x),
+                static_cast<i32>(chunk->position.y),
+                static_cast<i32>(chunk->position.z)
+            );
+    }
+
+    chunk->complete_generation();
+}
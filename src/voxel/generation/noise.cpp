@@ -0,0 +1,70 @@
+#include "stdafx.h"
+
+#include "voxel/generation/noise.h"
+
+// Level_Null while the level is not overridden.
+static std::atomic<FastSIMD::eLevel> g_simd_level_override = FastSIMD::Level_Null;
+
+FastSIMD::eLevel hvox::max_noise_simd_level() {
+    static const FastSIMD::eLevel max_level = FastSIMD::CPUMaxSIMDLevel();
+
+    return max_level;
+}
+
+FastSIMD::eLevel hvox::noise_simd_level() {
+    const FastSIMD::eLevel level
+        = g_simd_level_override.load(std::memory_order_relaxed);
+
+    if (level == FastSIMD::Level_Null) return max_noise_simd_level();
+
+    return level;
+}
+
+void hvox::override_noise_simd_level(FastSIMD::eLevel level) {
+    if (level > max_noise_simd_level()) level = max_noise_simd_level();
+
+    g_simd_level_override.store(level, std::memory_order_relaxed);
+}
+
+void hvox::threshold_noise(
+    const f32*   noise,
+    f32          threshold,
+    Block        above,
+    Block        below,
+    Block*       scratch,
+    BlockBuffer& blocks,
+    bool         flip_y /*= false*/
+) {
+    // Each row is thresholded whole and without branching, so that the
+    // compiler vectorises it, and counting blocks above the threshold as we
+    // go tells us if the chunk is uniform without scanning it again.
+    ui32 above_count = 0;
+    for (ui32 z = 0; z < CHUNK_LENGTH; ++z) {
+        for (ui32 y = 0; y < CHUNK_LENGTH; ++y) {
+            const ui32 block_y = flip_y ? CHUNK_LENGTH - y - 1 : y;
+
+            const f32* noise_row = noise + CHUNK_LENGTH * (y + CHUNK_LENGTH * z);
+            Block* block_row = scratch + CHUNK_LENGTH * (block_y + CHUNK_LENGTH * z);
+
+            for (ui32 x = 0; x < CHUNK_LENGTH; ++x) {
+                const bool is_above = noise_row[x] > threshold;
+
+                block_row[x].id  = is_above ? above.id : below.id;
+                above_count     += is_above;
+            }
+        }
+    }
+
+    if (above_count == 0 || above_count == CHUNK_VOLUME) {
+        blocks.fill(
+            BlockChunkPosition{ 0 },
+            BlockChunkPosition{ CHUNK_LENGTH - 1 },
+            above_count == 0 ? below : above
+        );
+        return;
+    }
+
+    // The scratch buffer is in x, then y, then z order, which copy lays out
+    // as blocks are laid out in the chunk.
+    blocks.copy(BlockChunkPosition{ 0 }, BlockChunkPosition{ CHUNK_LENGTH }, scratch);
+}
@@ -2,6 +2,7 @@
 
 #include "voxel/block.hpp"
 #include "voxel/chunk/chunk.h"
+#include "voxel/chunk/lod.h"
 
 #include "voxel/graphics/renderer.h"
 
@@ -30,7 +31,8 @@ hvox::ChunkRenderer::ChunkRenderer() :
 
         m_chunk_removal_queue.enqueue({ handle, chunk->id() });
     } }),
-    m_page_size(0) { /* Empty. */
+    m_page_size(0),
+    m_lods_changed(false) { /* Empty. */
 }
 
 void hvox::ChunkRenderer::init(ui32 page_size, ui32 max_unused_pages) {
@@ -100,6 +102,8 @@ void hvox::ChunkRenderer::update(FrameTime) {
     //                wait a bit in-case of a player moving fast?
 
     process_pages();
+
+    if (m_lods_changed) update_lod_levels();
 }
 
 void hvox::ChunkRenderer::draw(FrameTime) {
@@ -152,6 +156,36 @@ void hvox::ChunkRenderer::add_chunk(hmem::WeakHandle<Chunk> handle) {
 
     m_all_paged_chunks[chunk->id()] = handle;
     m_chunk_metadata[chunk->id()]   = PagedChunkMetadata{};
+
+    // The chunk is yet to be meshed, so it is simply meshed at the level of
+    // detail it starts at.
+    chunk->lod_level.store(lod_level_of(chunk->position), std::memory_order_release);
+}
+
+void hvox::ChunkRenderer::set_lod_distances(
+    const ui32* lod_distances, ui32 lod_distance_count
+) {
+    m_lod_distances.assign(lod_distances, lod_distances + lod_distance_count);
+    m_lods_changed = true;
+}
+
+void hvox::ChunkRenderer::set_focus_points(
+    const ChunkGridPosition* focus_points, ui32 focus_point_count
+) {
+    // Levels of detail only change as a focus point moves into another chunk.
+    if (focus_point_count == m_focus_points.size()
+        && std::equal(
+            focus_points,
+            focus_points + focus_point_count,
+            m_focus_points.begin(),
+            [](ChunkGridPosition lhs, ChunkGridPosition rhs) {
+                return lhs.id == rhs.id;
+            }
+        ))
+        return;
+
+    m_focus_points.assign(focus_points, focus_points + focus_point_count);
+    m_lods_changed = true;
 }
 
 hvox::ChunkRenderPage* hvox::ChunkRenderer::create_pages(ui32 count) {
@@ -552,3 +586,47 @@ void hvox::ChunkRenderer::process_pages() {
         }
     }
 }
+
+hvox::LODLevel
+hvox::ChunkRenderer::lod_level_of(ChunkGridPosition chunk_position) const {
+    if (m_focus_points.empty() || m_lod_distances.empty()) return 0;
+
+    // Render distance spans a cube about each focus point, so distance bands
+    // do too.
+    i64 distance = std::numeric_limits<i64>::max();
+    for (auto& focus_point : m_focus_points) {
+        i64 dx = std::abs(
+            static_cast<i64>(chunk_position.x) - static_cast<i64>(focus_point.x)
+        );
+        i64 dy = std::abs(
+            static_cast<i64>(chunk_position.y) - static_cast<i64>(focus_point.y)
+        );
+        i64 dz = std::abs(
+            static_cast<i64>(chunk_position.z) - static_cast<i64>(focus_point.z)
+        );
+
+        distance = std::min(distance, std::max({ dx, dy, dz }));
+    }
+
+    LODLevel lod_level = 0;
+    while (lod_level < MAX_LOD_LEVEL && lod_level < m_lod_distances.size()
+           && distance > static_cast<i64>(m_lod_distances[lod_level]))
+        ++lod_level;
+
+    return lod_level;
+}
+
+void hvox::ChunkRenderer::update_lod_levels() {
+    m_lods_changed = false;
+
+    for (auto& [id, handle] : m_all_paged_chunks) {
+        auto chunk = handle.lock();
+        if (chunk == nullptr) continue;
+
+        const LODLevel after = lod_level_of(chunk->position);
+        const LODLevel before
+            = chunk->lod_level.exchange(after, std::memory_order_acq_rel);
+
+        if (before != after) chunk->on_lod_change({ before, after });
+    }
+}
@@ -1,5 +1,3 @@
 #include "stdafx.h"
 
 #include "voxel/io/chunk_file_task.h"
-
-// hio::fs::mapped_file hvox::ChunkFileTask::chunk_data_file;
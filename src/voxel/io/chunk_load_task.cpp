@@ -1,14 +1,24 @@
 #include "stdafx.h"
 
-#include "io/iomanager.h"
+#include "voxel/chunk/chunk.h"
 
 #include "voxel/io/chunk_load_task.h"
 
-// static const char* REMOVE_ME = "REMOVE_ME_ASAAAAP";
+void hvox::ChunkLoadTask::execute(ChunkFileTaskThreadState*, ChunkFileTaskTaskQueue*) {
+    auto chunk = m_chunk.lock();
 
-// void hvox::ChunkLoadTask::execute(ChunkFileTaskThreadState*,
-// ChunkFileTaskTaskQueue*) {
-//     if (!chunk_data_file.is_open()) {
-//         m_iomanager->memory_map_file(hio::fs::path(REMOVE_ME), chunk_data_file);
-//     }
-// }
+    if (chunk == nullptr) return;
+
+    ChunkState none_state = ChunkState::NONE;
+    if (!chunk->generation.compare_exchange_strong(
+            none_state, ChunkState::ACTIVE, std::memory_order_acq_rel
+        ))
+        return;
+
+    if (!m_region_store->load_chunk(chunk)) {
+        chunk->generation.store(ChunkState::NONE, std::memory_order_release);
+        return;
+    }
+
+    chunk->complete_generation();
+}
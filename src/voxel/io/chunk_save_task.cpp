@@ -1,15 +1,22 @@
 #include "stdafx.h"
 
-#include "io/iomanager.h"
+#include "voxel/chunk/chunk.h"
 
 #include "voxel/io/chunk_save_task.h"
 
-// static const char* REMOVE_ME = "REMOVE_ME_ASAAAAP";
+void hvox::ChunkSaveTask::execute(ChunkFileTaskThreadState*, ChunkFileTaskTaskQueue*) {
+    auto chunk = m_chunk.lock();
 
-// void hvox::ChunkSaveTask::execute(ChunkFileTaskThreadState*,
-// ChunkFileTaskTaskQueue*) {
-//     if (!chunk_data_file.is_open()) {
-//         m_iomanager->memory_map_file(hio::fs::path(REMOVE_ME), chunk_data_file);
-//     }
+    if (chunk == nullptr) return;
 
-// }
+    if (chunk->generation.load(std::memory_order_acquire) != ChunkState::COMPLETE)
+        return;
+
+    // Taking the version before the blocks are read means that any change
+    // made while saving leaves the chunk to be saved again.
+    const ui64 version = chunk->blocks.version();
+    if (version == chunk->saved_version.load(std::memory_order_acquire)) return;
+
+    if (m_region_store->save_chunk(chunk))
+        chunk->saved_version.store(version, std::memory_order_release);
+}
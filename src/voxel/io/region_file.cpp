@@ -0,0 +1,528 @@
+#include "stdafx.h"
+
+#include "io/iomanager.h"
+#include "voxel/block_layout.hpp"
+#include "voxel/chunk/chunk.h"
+
+#include "voxel/io/region_file.h"
+
+// "HRGN" read as a little-endian ui32.
+static constexpr ui32 REGION_MAGIC   = 0x4E475248;
+static constexpr ui32 REGION_VERSION = 1;
+
+// Files with less than this many superseded bytes are never compacted, so
+// that small regions aren't rewritten over and over.
+static constexpr ui64 MIN_COMPACTION_BYTES = 1 << 20;
+
+static_assert(
+    CHUNK_VOLUME <= std::numeric_limits<ui16>::max(),
+    "Chunk records hold the length of each run, and the index of each edit, in two "
+    "bytes."
+);
+
+enum class ChunkRecordFormat : ui8 {
+    UNIFORM = 0,
+    RUNS    = 1,
+    DELTA   = 2
+};
+
+// Each record starts with its format and the width of the block IDs in it, so
+// that records written with a different block ID width are recognised rather
+// than misread.
+static constexpr size_t RECORD_PREAMBLE = 2;
+static constexpr size_t RUN_SIZE        = sizeof(ui16) + sizeof(hvox::BlockID);
+static constexpr size_t EDIT_SIZE       = sizeof(ui16) + sizeof(hvox::BlockID);
+
+static i64 region_coord(i64 coord) {
+    constexpr i64 LENGTH = static_cast<i64>(hvox::REGION_LENGTH);
+    return (coord - ((coord % LENGTH + LENGTH) % LENGTH)) / LENGTH;
+}
+
+static ui32 local_coord(i64 coord) {
+    constexpr i64 LENGTH = static_cast<i64>(hvox::REGION_LENGTH);
+    return static_cast<ui32>((coord % LENGTH + LENGTH) % LENGTH);
+}
+
+// Records hold blocks in linear order, along x, then y, then z, whatever the
+// layout this build holds blocks in, so that a save may be read by a build of
+// any layout.
+static ui16 record_index(hvox::BlockIndex index) {
+    if constexpr (hvox::BLOCK_LAYOUT == hvox::BlockLayout::LINEAR) {
+        return static_cast<ui16>(index);
+    } else {
+        const hvox::BlockChunkPosition position = hvox::block_chunk_position(index);
+        return static_cast<ui16>(
+            position.x + position.y * CHUNK_LENGTH + position.z * CHUNK_AREA
+        );
+    }
+}
+
+static hvox::BlockIndex buffer_index(ui16 index) {
+    if constexpr (hvox::BLOCK_LAYOUT == hvox::BlockLayout::LINEAR) {
+        return index;
+    } else {
+        return hvox::block_index(hvox::BlockChunkPosition{
+            index % CHUNK_LENGTH,
+            (index / CHUNK_LENGTH) % CHUNK_LENGTH,
+            index / (CHUNK_AREA) });
+    }
+}
+
+static void append_run(std::vector<ui8>& record, ui16 length, hvox::Block block) {
+    const size_t offset = record.size();
+    record.resize(offset + RUN_SIZE);
+    std::memcpy(&record[offset], &length, sizeof(ui16));
+    std::memcpy(&record[offset + sizeof(ui16)], &block.id, sizeof(hvox::BlockID));
+}
+
+hvox::ChunkGridPosition hvox::region_position(ChunkGridPosition chunk_position) {
+    ChunkGridPosition position;
+    position.x = region_coord(chunk_position.x);
+    position.y = region_coord(chunk_position.y);
+    position.z = region_coord(chunk_position.z);
+    return position;
+}
+
+ui32 hvox::region_index(ChunkGridPosition chunk_position) {
+    return local_coord(chunk_position.x)
+           + local_coord(chunk_position.y) * REGION_LENGTH
+           + local_coord(chunk_position.z) * REGION_LENGTH * REGION_LENGTH;
+}
+
+void hvox::encode_chunk_record(
+    const BlockBuffer& blocks, OUT std::vector<ui8>& record
+) {
+    record.clear();
+
+    if (blocks.is_uniform()) {
+        record.resize(RECORD_PREAMBLE + sizeof(BlockID));
+        record[0] = static_cast<ui8>(ChunkRecordFormat::UNIFORM);
+        record[1] = sizeof(BlockID);
+        std::memcpy(&record[RECORD_PREAMBLE], &blocks[0].id, sizeof(BlockID));
+        return;
+    }
+
+    record.push_back(static_cast<ui8>(ChunkRecordFormat::RUNS));
+    record.push_back(sizeof(BlockID));
+
+    Block run_block  = blocks[buffer_index(0)];
+    ui16  run_length = 1;
+    for (ui32 index = 1; index < CHUNK_VOLUME; ++index) {
+        const Block& block = blocks[buffer_index(static_cast<ui16>(index))];
+        if (block == run_block) {
+            ++run_length;
+            continue;
+        }
+
+        append_run(record, run_length, run_block);
+        run_block  = block;
+        run_length = 1;
+    }
+    append_run(record, run_length, run_block);
+}
+
+void hvox::encode_chunk_record(
+    const BlockBuffer& blocks, const ChunkEdits& edits, OUT std::vector<ui8>& record
+) {
+    encode_chunk_record(blocks, record);
+
+    if (!edits.is_delta()) return;
+
+    std::vector<ui16> indices(edits.indices.size());
+    std::transform(
+        edits.indices.begin(), edits.indices.end(), indices.begin(), record_index
+    );
+    std::sort(indices.begin(), indices.end());
+    indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+
+    // Chunks of few runs, e.g. those not much more than a floor, are often
+    // smaller whole than as even a modest number of edits.
+    const size_t delta_size = RECORD_PREAMBLE + indices.size() * EDIT_SIZE;
+    if (delta_size >= record.size()) return;
+
+    record.resize(delta_size);
+    record[0] = static_cast<ui8>(ChunkRecordFormat::DELTA);
+    record[1] = sizeof(BlockID);
+
+    size_t offset = RECORD_PREAMBLE;
+    for (ui16 index : indices) {
+        const BlockID id = blocks[buffer_index(index)].id;
+        std::memcpy(&record[offset], &index, sizeof(ui16));
+        std::memcpy(&record[offset + sizeof(ui16)], &id, sizeof(BlockID));
+        offset += EDIT_SIZE;
+    }
+}
+
+bool hvox::is_delta_record(const ui8* record, size_t length) {
+    return length >= RECORD_PREAMBLE
+           && static_cast<ChunkRecordFormat>(record[0]) == ChunkRecordFormat::DELTA;
+}
+
+bool hvox::decode_chunk_record(
+    const ui8* record, size_t length, BlockBuffer& blocks, ChunkEdits& edits
+) {
+    if (length < RECORD_PREAMBLE || record[1] != sizeof(BlockID)) return false;
+
+    const ui8*   data      = record + RECORD_PREAMBLE;
+    const size_t data_size = length - RECORD_PREAMBLE;
+
+    switch (static_cast<ChunkRecordFormat>(record[0])) {
+        case ChunkRecordFormat::UNIFORM:
+        {
+            if (data_size != sizeof(BlockID)) return false;
+
+            Block block;
+            std::memcpy(&block.id, data, sizeof(BlockID));
+            blocks.fill(
+                BlockChunkPosition{ 0 }, BlockChunkPosition{ CHUNK_LENGTH - 1 }, block
+            );
+            edits.mark_all();
+            return true;
+        }
+        case ChunkRecordFormat::RUNS:
+        {
+            if (data_size == 0 || data_size % RUN_SIZE != 0) return false;
+
+            // Check the runs cover the chunk exactly before writing any block.
+            size_t total = 0;
+            for (size_t offset = 0; offset < data_size; offset += RUN_SIZE) {
+                ui16 run_length;
+                std::memcpy(&run_length, data + offset, sizeof(ui16));
+                if (run_length == 0) return false;
+                total += run_length;
+            }
+            if (total != CHUNK_VOLUME) return false;
+
+            // Filling with the first run's block first means its blocks need
+            // not be set one by one, and that a chunk of few runs doesn't
+            // expand its buffer until it must.
+            Block first_block;
+            std::memcpy(&first_block.id, data + sizeof(ui16), sizeof(BlockID));
+            blocks.fill(
+                BlockChunkPosition{ 0 },
+                BlockChunkPosition{ CHUNK_LENGTH - 1 },
+                first_block
+            );
+
+            ui32 index = 0;
+            for (size_t offset = 0; offset < data_size; offset += RUN_SIZE) {
+                ui16  run_length;
+                Block block;
+                std::memcpy(&run_length, data + offset, sizeof(ui16));
+                std::memcpy(&block.id, data + offset + sizeof(ui16), sizeof(BlockID));
+
+                if (block != first_block) {
+                    for (ui32 i = index; i < index + run_length; ++i)
+                        blocks.set(buffer_index(static_cast<ui16>(i)), block);
+                }
+                index += run_length;
+            }
+            edits.mark_all();
+            return true;
+        }
+        case ChunkRecordFormat::DELTA:
+        {
+            if (data_size % EDIT_SIZE != 0) return false;
+
+            for (size_t offset = 0; offset < data_size; offset += EDIT_SIZE) {
+                ui16 index;
+                std::memcpy(&index, data + offset, sizeof(ui16));
+                if (index >= CHUNK_VOLUME) return false;
+            }
+
+            // The edits are kept so that the chunk's next save holds them
+            // along with any made since.
+            for (size_t offset = 0; offset < data_size; offset += EDIT_SIZE) {
+                ui16  index;
+                Block block;
+                std::memcpy(&index, data + offset, sizeof(ui16));
+                std::memcpy(&block.id, data + offset + sizeof(ui16), sizeof(BlockID));
+
+                const BlockIndex block_index = buffer_index(index);
+                blocks.set(block_index, block);
+                if (edits.is_delta())
+                    edits.indices.push_back(static_cast<ui16>(block_index));
+            }
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+hvox::ChunkRegionFile::ChunkRegionFile() : m_iomanager(nullptr) {
+    // Empty.
+}
+
+bool hvox::ChunkRegionFile::init(
+    io::IOManagerBase* iomanager, const hio::fs::path& path
+) {
+    m_iomanager = iomanager;
+    m_path      = path;
+
+    hio::fs::path full_path{};
+    if (!m_iomanager->resolve_path(m_path, full_path)) return false;
+
+    const bool is_new = !hio::fs::exists(full_path);
+    if (is_new) {
+        // Mapping needs the file to exist and hold at least its header.
+        {
+            std::ofstream file(full_path, std::ios::binary);
+            if (!file) return false;
+        }
+        hio::fs::resize_file(full_path, sizeof(ChunkRegionHeader));
+    } else if (hio::fs::file_size(full_path) < sizeof(ChunkRegionHeader)) {
+        return false;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(m_file_mutex);
+
+    if (!m_iomanager->memory_map_file(m_path, m_file) || !m_file.is_open())
+        return false;
+
+    if (is_new) {
+        ChunkRegionHeader* new_header = header();
+        std::memset(new_header, 0, sizeof(ChunkRegionHeader));
+        new_header->magic   = REGION_MAGIC;
+        new_header->version = REGION_VERSION;
+        new_header->end     = sizeof(ChunkRegionHeader);
+        return true;
+    }
+
+    if (header()->magic != REGION_MAGIC || header()->version != REGION_VERSION) {
+        m_file.close();
+        return false;
+    }
+
+    return true;
+}
+
+void hvox::ChunkRegionFile::dispose() {
+    std::unique_lock<std::shared_mutex> lock(m_file_mutex);
+
+    if (m_file.is_open()) m_file.close();
+
+    m_iomanager = nullptr;
+}
+
+bool hvox::ChunkRegionFile::read(ui32 index, OUT std::vector<ui8>& record) const {
+    std::shared_lock<std::shared_mutex> lock(m_file_mutex);
+
+    if (!m_file.is_open() || index >= REGION_VOLUME) return false;
+
+    const ChunkRegionEntry& entry = header()->entries[index];
+    if (entry.length == 0 || entry.offset + entry.length > header()->end) return false;
+
+    const ui8* data = reinterpret_cast<const ui8*>(m_file.const_data()) + entry.offset;
+    record.assign(data, data + entry.length);
+
+    return true;
+}
+
+bool hvox::ChunkRegionFile::write(const ChunkRecord* records, size_t record_count) {
+    std::unique_lock<std::shared_mutex> lock(m_file_mutex);
+
+    if (!m_file.is_open()) return false;
+
+    size_t length = 0;
+    for (size_t i = 0; i < record_count; ++i) {
+        if (records[i].data.empty()) return false;
+        length += records[i].data.size();
+    }
+
+    ui64 offset = header()->end;
+    if (offset + length > m_file.size()) {
+        // Grow geometrically so that a run of appends remaps the file only
+        // a few times.
+        m_file.resize(std::max<size_t>(offset + length, m_file.size() * 2));
+    }
+
+    ChunkRegionHeader* region_header = header();
+    for (size_t i = 0; i < record_count; ++i) {
+        const std::vector<ui8>& data = records[i].data;
+
+        std::memcpy(m_file.data() + offset, data.data(), data.size());
+
+        // The record is in place before any entry points at it.
+        ChunkRegionEntry& entry
+            = region_header->entries[region_index(records[i].position)];
+
+        region_header->dead_bytes += entry.length;
+        entry.offset               = offset;
+        entry.length               = static_cast<ui32>(data.size());
+        offset                    += data.size();
+        region_header->end         = offset;
+    }
+
+    const ui64 live_bytes
+        = region_header->end - sizeof(ChunkRegionHeader) - region_header->dead_bytes;
+    if (region_header->dead_bytes >= MIN_COMPACTION_BYTES
+        && region_header->dead_bytes > live_bytes)
+        compact_locked();
+
+    return true;
+}
+
+void hvox::ChunkRegionFile::compact() {
+    std::unique_lock<std::shared_mutex> lock(m_file_mutex);
+
+    if (!m_file.is_open()) return;
+
+    compact_locked();
+}
+
+size_t hvox::ChunkRegionFile::dead_bytes() const {
+    std::shared_lock<std::shared_mutex> lock(m_file_mutex);
+
+    if (!m_file.is_open()) return 0;
+
+    return header()->dead_bytes;
+}
+
+void hvox::ChunkRegionFile::compact_locked() {
+    ChunkRegionHeader* region_header = header();
+
+    // Records are moved in the order they lie in the file, so each only
+    // ever moves towards the front, over records already moved or dead.
+    std::vector<std::pair<ui64, ui32>> records;
+    for (ui32 index = 0; index < REGION_VOLUME; ++index) {
+        if (region_header->entries[index].length != 0)
+            records.emplace_back(region_header->entries[index].offset, index);
+    }
+    std::sort(records.begin(), records.end());
+
+    ui64 end = sizeof(ChunkRegionHeader);
+    for (auto& [offset, index] : records) {
+        ChunkRegionEntry& entry = region_header->entries[index];
+        if (offset != end)
+            std::memmove(m_file.data() + end, m_file.data() + offset, entry.length);
+
+        entry.offset  = end;
+        end          += entry.length;
+    }
+
+    region_header->end        = end;
+    region_header->dead_bytes = 0;
+
+    m_file.resize(end);
+}
+
+hvox::ChunkRegionStore::ChunkRegionStore() : m_iomanager(nullptr) {
+    // Empty.
+}
+
+void hvox::ChunkRegionStore::init(
+    io::IOManagerBase* iomanager, const hio::fs::path& directory
+) {
+    m_iomanager = iomanager;
+    m_directory = directory;
+
+    hio::fs::path full_directory{};
+    m_iomanager->assure_path(m_directory, full_directory);
+}
+
+void hvox::ChunkRegionStore::dispose() {
+    std::lock_guard<std::mutex> lock(m_regions_mutex);
+
+    for (auto& [id, region] : m_regions) region->dispose();
+    std::unordered_map<ChunkID, hmem::Handle<ChunkRegionFile>>().swap(m_regions);
+
+    m_iomanager = nullptr;
+}
+
+bool hvox::ChunkRegionStore::load_chunk(hmem::Handle<Chunk> chunk) {
+    std::vector<ui8> record;
+    if (!read_record(chunk->position, record)) return false;
+
+    // Deltas only make sense applied to the chunk as generated.
+    if (is_delta_record(record.data(), record.size())) return false;
+
+    std::unique_lock<std::shared_mutex> lock;
+    BlockBuffer&                        blocks = chunk->blocks.get(lock);
+
+    return decode_chunk_record(record.data(), record.size(), blocks, chunk->edits);
+}
+
+bool hvox::ChunkRegionStore::read_record(
+    ChunkGridPosition chunk_position, OUT std::vector<ui8>& record
+) {
+    auto chunk_region = region(chunk_position, false);
+    if (chunk_region == nullptr) return false;
+
+    return chunk_region->read(region_index(chunk_position), record);
+}
+
+bool hvox::ChunkRegionStore::save_chunk(hmem::Handle<Chunk> chunk) {
+    ChunkRecord record{ chunk->position, {} };
+    {
+        std::shared_lock<std::shared_mutex> lock;
+        const BlockBuffer&                  blocks = chunk->blocks.get(lock);
+
+        encode_chunk_record(blocks, chunk->edits, record.data);
+    }
+
+    return save_records(&record, 1);
+}
+
+bool hvox::ChunkRegionStore::save_records(
+    const ChunkRecord* records, size_t record_count
+) {
+    bool saved_all = true;
+
+    size_t start = 0;
+    while (start < record_count) {
+        const ChunkID region_id = region_position(records[start].position).id;
+
+        size_t end = start + 1;
+        while (end < record_count
+               && region_position(records[end].position).id == region_id)
+            ++end;
+
+        auto chunk_region = region(records[start].position, true);
+        if (chunk_region == nullptr
+            || !chunk_region->write(records + start, end - start))
+            saved_all = false;
+
+        start = end;
+    }
+
+    return saved_all;
+}
+
+void hvox::ChunkRegionStore::compact() {
+    std::lock_guard<std::mutex> lock(m_regions_mutex);
+
+    for (auto& [id, region] : m_regions) region->compact();
+}
+
+hmem::Handle<hvox::ChunkRegionFile>
+hvox::ChunkRegionStore::region(ChunkGridPosition chunk_position, bool create) {
+    const ChunkGridPosition position = region_position(chunk_position);
+
+    std::lock_guard<std::mutex> lock(m_regions_mutex);
+
+    if (m_iomanager == nullptr) return nullptr;
+
+    auto it = m_regions.find(position.id);
+    if (it != m_regions.end()) return it->second;
+
+    hio::fs::path path = m_directory
+                         / ("r." + std::to_string(position.x) + "."
+                            + std::to_string(position.y) + "."
+                            + std::to_string(position.z) + ".hrg");
+
+    // Regions nothing has been saved to are not created just to be read.
+    if (!create) {
+        hio::fs::path full_path{};
+        if (!m_iomanager->resolve_path(path, full_path)
+            || !hio::fs::exists(full_path))
+            return nullptr;
+    }
+
+    auto new_region = hmem::make_handle<ChunkRegionFile>();
+    if (!new_region->init(m_iomanager, path)) return nullptr;
+
+    m_regions[position.id] = new_region;
+
+    return new_region;
+}
@@ -0,0 +1,349 @@
+#include "stdafx.h"
+
+#include "io/iomanager.h"
+#include "voxel/chunk/chunk.h"
+
+#include "voxel/io/save_queue.h"
+
+#if defined(HEMLOCK_OS_WINDOWS)
+#  include <io.h>
+#else
+#  include <fcntl.h>
+#  include <unistd.h>
+#endif
+
+static const char* JOURNAL_PREFIX    = "j.";
+static const char* JOURNAL_EXTENSION = ".hrj";
+
+static hio::fs::path journal_path(const hio::fs::path& directory, ui64 journal) {
+    return directory / (JOURNAL_PREFIX + std::to_string(journal) + JOURNAL_EXTENSION);
+}
+
+static bool parse_journal_path(const hio::fs::path& path, OUT ui64& journal) {
+    if (path.extension() != JOURNAL_EXTENSION) return false;
+
+    const std::string stem   = path.stem().string();
+    const size_t      prefix = std::strlen(JOURNAL_PREFIX);
+    if (stem.size() <= prefix || stem.compare(0, prefix, JOURNAL_PREFIX) != 0)
+        return false;
+
+    char* end = nullptr;
+    journal   = std::strtoull(stem.data() + prefix, &end, 10);
+
+    return end == stem.data() + stem.size();
+}
+
+// fflush only hands the file's buffers to the OS, which may yet lose them to a
+// crash or power cut, so we also have the OS write them through to disk.
+static bool sync_file(FILE* file) {
+    if (std::fflush(file) != 0) return false;
+
+#if defined(HEMLOCK_OS_WINDOWS)
+    return _commit(_fileno(file)) == 0;
+#else
+    return fsync(fileno(file)) == 0;
+#endif
+}
+
+// A newly created file may still be lost with its directory's entry for it
+// unless that too is written through. Windows offers no such sync and needn't
+// have it, as NTFS journals its directory changes.
+static void sync_directory([[maybe_unused]] const hio::fs::path& directory) {
+#if !defined(HEMLOCK_OS_WINDOWS)
+    int fd = open(directory.c_str(), O_RDONLY);
+    if (fd < 0) return;
+
+    fsync(fd);
+    close(fd);
+#endif
+}
+
+void hvox::ChunkSaveBatchTask::init(
+    ChunkSaveQueue* save_queue, std::vector<ChunkSave>&& saves
+) {
+    io::IOTask::init(save_queue->region_store()->iomanager());
+
+    m_save_queue = save_queue;
+    m_saves      = std::move(saves);
+}
+
+void hvox::ChunkSaveBatchTask::execute(io::IOTaskThreadState*, io::IOTaskTaskQueue*) {
+    std::vector<ChunkRecord> records(m_saves.size());
+    for (size_t i = 0; i < m_saves.size(); ++i) {
+        records[i].position = m_saves[i].position;
+        encode_chunk_record(
+            m_saves[i].blocks->blocks(), m_saves[i].edits, records[i].data
+        );
+    }
+
+    // Journalling first means that, whenever we crash, a journal holds any
+    // save the region file may not.
+    ui64 journal = m_save_queue->journal(records);
+
+    // Should the write fail, the journal is kept for the saves to be written
+    // on the next initialisation.
+    if (m_save_queue->region_store()->save_records(records.data(), records.size())) {
+        m_save_queue->retire_journal(journal);
+    } else {
+        debug_printf("Failed to write %zu chunk saves.\n", records.size());
+    }
+
+    // The blocks, and any page they hold, are released with this task.
+    m_save_queue->complete(m_saves);
+}
+
+hvox::ChunkSaveQueue::ChunkSaveQueue() :
+    m_region_store(nullptr),
+    m_flush_interval(0),
+    m_since_flush(0),
+    m_next_journal(0) {
+    // Empty.
+}
+
+void hvox::ChunkSaveQueue::init(
+    ChunkRegionStore* region_store,
+    ui32              thread_count /*= 1*/,
+    FrameTime         flush_interval /*= std::chrono::seconds(1)*/
+) {
+    m_region_store   = region_store;
+    m_flush_interval = flush_interval;
+    m_since_flush    = FrameTime{ 0 };
+
+    m_region_store->iomanager()->resolve_path(
+        m_region_store->directory(), m_journal_directory
+    );
+
+    replay_journals();
+
+    m_thread_pool.init(thread_count);
+}
+
+void hvox::ChunkSaveQueue::dispose() {
+    // Saves held back by one flush are flushed by the next.
+    while (true) {
+        flush();
+        wait();
+
+        std::lock_guard<std::mutex> lock(m_saves_mutex);
+        if (m_queued_saves.empty()) break;
+    }
+
+    m_thread_pool.dispose();
+
+    {
+        std::lock_guard<std::mutex> lock(m_journal_mutex);
+
+        m_journals.clear();
+    }
+
+    std::unordered_map<ChunkID, ChunkSave>().swap(m_queued_saves);
+    std::unordered_map<ChunkID, ChunkSave>().swap(m_flushed_saves);
+    std::unordered_map<ChunkID, std::vector<ChunkSave>>().swap(m_batches);
+
+    m_region_store = nullptr;
+}
+
+void hvox::ChunkSaveQueue::enqueue(
+    ChunkGridPosition position, BlockSnapshotHandle blocks, ChunkEdits edits
+) {
+    std::lock_guard<std::mutex> lock(m_saves_mutex);
+
+    m_queued_saves[position.id]
+        = ChunkSave{ position, std::move(blocks), std::move(edits) };
+}
+
+void hvox::ChunkSaveQueue::update(FrameTime time) {
+    m_since_flush += time;
+    if (m_since_flush < m_flush_interval) return;
+
+    flush();
+}
+
+void hvox::ChunkSaveQueue::flush() {
+    m_since_flush = FrameTime{ 0 };
+
+    {
+        std::lock_guard<std::mutex> lock(m_saves_mutex);
+
+        for (auto it = m_queued_saves.begin(); it != m_queued_saves.end();) {
+            if (m_flushed_saves.contains(it->first)) {
+                ++it;
+                continue;
+            }
+
+            m_flushed_saves.emplace(it->first, it->second);
+            m_batches[region_position(it->second.position).id].emplace_back(
+                std::move(it->second)
+            );
+
+            it = m_queued_saves.erase(it);
+        }
+    }
+
+    for (auto& [id, saves] : m_batches) {
+        auto task = new ChunkSaveBatchTask();
+        task->init(this, std::move(saves));
+
+        m_thread_pool.add_task({ task, true });
+    }
+    m_batches.clear();
+}
+
+void hvox::ChunkSaveQueue::wait() {
+    std::unique_lock<std::mutex> lock(m_saves_mutex);
+
+    m_saves_written.wait(lock, [&]() { return m_flushed_saves.empty(); });
+}
+
+bool hvox::ChunkSaveQueue::read_record(
+    ChunkGridPosition chunk_position, OUT std::vector<ui8>& record
+) {
+    ChunkSave save;
+    {
+        std::lock_guard<std::mutex> lock(m_saves_mutex);
+
+        // Queued saves are newer than any flushed save of the same chunk.
+        auto it = m_queued_saves.find(chunk_position.id);
+        if (it != m_queued_saves.end()) {
+            save = it->second;
+        } else {
+            it = m_flushed_saves.find(chunk_position.id);
+            if (it == m_flushed_saves.end()) return false;
+
+            save = it->second;
+        }
+    }
+
+    encode_chunk_record(save.blocks->blocks(), save.edits, record);
+
+    return true;
+}
+
+ui64 hvox::ChunkSaveQueue::journal(const std::vector<ChunkRecord>& records) {
+    ui64 journal;
+    {
+        std::lock_guard<std::mutex> lock(m_journal_mutex);
+
+        journal = m_next_journal++;
+        m_journals.emplace(journal, false);
+    }
+
+    FILE* file
+        = std::fopen(journal_path(m_journal_directory, journal).string().data(), "wb");
+    if (file == nullptr) return journal;
+
+    for (auto& record : records) {
+        const ChunkID id     = record.position.id;
+        const ui32    length = static_cast<ui32>(record.data.size());
+
+        std::fwrite(&id, sizeof(ChunkID), 1, file);
+        std::fwrite(&length, sizeof(ui32), 1, file);
+        std::fwrite(record.data.data(), 1, length, file);
+    }
+
+    if (!sync_file(file)) {
+        debug_printf(
+            "Failed to sync journal %llu to disk.\n",
+            static_cast<unsigned long long>(journal)
+        );
+    }
+    std::fclose(file);
+
+    sync_directory(m_journal_directory);
+
+    return journal;
+}
+
+void hvox::ChunkSaveQueue::retire_journal(ui64 journal) {
+    std::lock_guard<std::mutex> lock(m_journal_mutex);
+
+    m_journals[journal] = true;
+
+    // A later journal may hold newer saves of the chunks of an earlier one,
+    // so journals are only removed in the order they were written.
+    for (auto it = m_journals.begin(); it != m_journals.end() && it->second;) {
+        std::error_code ec;
+        hio::fs::remove(journal_path(m_journal_directory, it->first), ec);
+
+        it = m_journals.erase(it);
+    }
+}
+
+void hvox::ChunkSaveQueue::replay_journals() {
+    io::IOManagerBase* iomanager = m_region_store->iomanager();
+
+    std::map<ui64, hio::fs::path> journals;
+    {
+        std::error_code ec;
+        for (const auto& entry :
+             hio::fs::directory_iterator{ m_journal_directory, ec })
+        {
+            ui64 journal;
+            if (parse_journal_path(entry.path(), journal))
+                journals.emplace(journal, entry.path());
+        }
+    }
+
+    if (journals.empty()) return;
+
+    bool                     read_all = true;
+    std::vector<ChunkRecord> records;
+    for (auto& [journal, path] : journals) {
+        std::vector<ui8> data;
+        if (!iomanager->read_file_to_binary(path, data)) {
+            read_all = false;
+            continue;
+        }
+
+        // A crash mid-write may leave the last record cut short, in which
+        // case it was never written to its region file either and is
+        // dropped.
+        size_t offset = 0;
+        while (offset + sizeof(ChunkID) + sizeof(ui32) <= data.size()) {
+            ChunkRecord record;
+            ui32        length;
+            std::memcpy(&record.position.id, &data[offset], sizeof(ChunkID));
+            std::memcpy(&length, &data[offset + sizeof(ChunkID)], sizeof(ui32));
+            offset += sizeof(ChunkID) + sizeof(ui32);
+
+            if (offset + length > data.size()) break;
+
+            record.data.assign(data.begin() + offset, data.begin() + offset + length);
+            offset += length;
+
+            records.emplace_back(std::move(record));
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(m_journal_mutex);
+
+    // New journals follow on from those left over, so that, should any be
+    // kept, they are replayed before the newer saves.
+    m_next_journal = journals.rbegin()->first + 1;
+
+    // Records are written in the order they were journalled, so the latest
+    // of each chunk is the one its region file is left with. Until all are
+    // written, the journals are kept to be replayed again.
+    if (!m_region_store->save_records(records.data(), records.size()) || !read_all)
+    {
+        debug_printf("Failed to replay %zu chunk saves.\n", records.size());
+        return;
+    }
+
+    for (auto& [journal, path] : journals) {
+        std::error_code ec;
+        hio::fs::remove(path, ec);
+    }
+}
+
+void hvox::ChunkSaveQueue::complete(const std::vector<ChunkSave>& saves) {
+    std::lock_guard<std::mutex> lock(m_saves_mutex);
+
+    for (auto& save : saves) {
+        auto it = m_flushed_saves.find(save.position.id);
+        if (it != m_flushed_saves.end() && it->second.blocks == save.blocks)
+            m_flushed_saves.erase(it);
+    }
+
+    if (m_flushed_saves.empty()) m_saves_written.notify_all();
+}
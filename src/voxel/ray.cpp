@@ -178,6 +178,16 @@ bool hvox::Ray::cast_to_block(
 
     if (chunk_tmp == nullptr) return false;
 
+    chunk_grid->touch_chunk(old_chunk_pos, ChunkDehydration::BLOCKS);
+
+    // Chunks known, as of the last update, to hold only null blocks can be
+    // passed through without reading their blocks, unless the null block is
+    // itself a target.
+    const bool can_skip_empty = !block_is_target(NULL_BLOCK);
+    bool       skip_chunk
+        = can_skip_empty
+          && chunk_grid->columns().content(old_chunk_pos) == ChunkContent::EMPTY;
+
     do {
         step_to_next_block_position(
             start, position, steps_to_next, step, delta, direction, distance
@@ -190,12 +200,20 @@ bool hvox::Ray::cast_to_block(
 
             // TODO(Matthew): do we want to allow "seeing through" unloaded chunks?
             if (chunk_tmp == nullptr) return false;
+
+            chunk_grid->touch_chunk(new_chunk_pos, ChunkDehydration::BLOCKS);
+
+            skip_chunk = can_skip_empty
+                         && chunk_grid->columns().content(new_chunk_pos)
+                                == ChunkContent::EMPTY;
         }
 
         old_chunk_pos = new_chunk_pos;
 
+        if (skip_chunk) continue;
+
         std::shared_lock<std::shared_mutex> lock;
-        auto                                chunk_blocks = chunk_tmp->blocks.get(lock);
+        auto&                               chunk_blocks = chunk_tmp->blocks.get(lock);
 
         auto idx = block_index(block_chunk_position(position));
 
@@ -272,6 +290,16 @@ bool hvox::Ray::cast_to_block_before(
 
     if (chunk_tmp == nullptr) return false;
 
+    chunk_grid->touch_chunk(old_chunk_pos, ChunkDehydration::BLOCKS);
+
+    // Chunks known, as of the last update, to hold only null blocks can be
+    // passed through without reading their blocks, unless the null block is
+    // itself a target.
+    const bool can_skip_empty = !block_is_target(NULL_BLOCK);
+    bool       skip_chunk
+        = can_skip_empty
+          && chunk_grid->columns().content(old_chunk_pos) == ChunkContent::EMPTY;
+
     do {
         f32 step_distance = 0.0f;
         step_to_next_block_position(
@@ -285,12 +313,24 @@ bool hvox::Ray::cast_to_block_before(
 
             // TODO(Matthew): do we want to allow "seeing through" unloaded chunks?
             if (chunk_tmp == nullptr) return false;
+
+            chunk_grid->touch_chunk(new_chunk_pos, ChunkDehydration::BLOCKS);
+
+            skip_chunk = can_skip_empty
+                         && chunk_grid->columns().content(new_chunk_pos)
+                                == ChunkContent::EMPTY;
         }
 
         old_chunk_pos = new_chunk_pos;
 
+        if (skip_chunk) {
+            distance += step_distance;
+            position  = block_position;
+            continue;
+        }
+
         std::shared_lock<std::shared_mutex> lock;
-        auto                                chunk_blocks = chunk_tmp->blocks.get(lock);
+        auto&                               chunk_blocks = chunk_tmp->blocks.get(lock);
 
         auto idx = block_index(block_chunk_position(block_position));
 
@@ -12,6 +12,7 @@
 #include "voxel/ai/navmesh/strategy/naive/strategy.hpp"
 #include "voxel/ai/navmesh/view.hpp"
 #include "voxel/generation/generator_task.hpp"
+#include "voxel/generation/noise.h"
 #include "voxel/graphics/mesh/greedy_strategy.hpp"
 #include "voxel/graphics/mesh/mesh_task.hpp"
 #include "voxel/graphics/outline_renderer.hpp"
@@ -5,55 +5,62 @@ namespace hemlock {
     namespace test {
         namespace navmesh_screen {
             struct VoxelGenerator {
-                void operator()(hmem::Handle<hvox::Chunk> chunk) const {
-                    auto simplex_1
-                        = FastNoise::New<FastNoise::Simplex>(FastSIMD::Level_AVX512);
-                    auto fractal_1
-                        = FastNoise::New<FastNoise::FractalFBm>(FastSIMD::Level_AVX512);
-                    auto domain_scale_1
-                        = FastNoise::New<FastNoise::DomainScale>(FastSIMD::Level_AVX512
-                        );
-                    auto position_output_1 = FastNoise::New<FastNoise::PositionOutput>(
-                        FastSIMD::Level_AVX512
-                    );
-                    auto add_1 = FastNoise::New<FastNoise::Add>(FastSIMD::Level_AVX512);
-                    auto domain_warp_grad_1
-                        = FastNoise::New<FastNoise::DomainWarpGradient>(
-                            FastSIMD::Level_AVX512
-                        );
-                    auto domain_warp_fract_prog_1
-                        = FastNoise::New<FastNoise::DomainWarpFractalProgressive>(
-                            FastSIMD::Level_AVX512
-                        );
+                // Built once per thread, rather than once per chunk.
+                struct ThreadState {
+                    ThreadState() {
+                        auto simplex_1 = hvox::new_noise_node<FastNoise::Simplex>();
+                        auto fractal_1
+                            = hvox::new_noise_node<FastNoise::FractalFBm>();
+                        auto domain_scale_1
+                            = hvox::new_noise_node<FastNoise::DomainScale>();
+                        auto position_output_1
+                            = hvox::new_noise_node<FastNoise::PositionOutput>();
+                        auto add_1 = hvox::new_noise_node<FastNoise::Add>();
+                        auto domain_warp_grad_1
+                            = hvox::new_noise_node<FastNoise::DomainWarpGradient>();
+                        auto domain_warp_fract_prog_1 = hvox::new_noise_node<
+                            FastNoise::DomainWarpFractalProgressive>();
+
+                        fractal_1->SetSource(simplex_1);
+                        fractal_1->SetOctaveCount(4);
+                        fractal_1->SetGain(0.5f);
+                        fractal_1->SetLacunarity(2.5f);
 
-                    fractal_1->SetSource(simplex_1);
-                    fractal_1->SetOctaveCount(4);
-                    fractal_1->SetGain(0.5f);
-                    fractal_1->SetLacunarity(2.5f);
+                        domain_scale_1->SetSource(fractal_1);
+                        domain_scale_1->SetScale(0.66f);
 
-                    domain_scale_1->SetSource(fractal_1);
-                    domain_scale_1->SetScale(0.66f);
+                        position_output_1->Set<FastNoise::Dim::X>(0.0f);
+                        position_output_1->Set<FastNoise::Dim::Y>(3.0f);
+                        position_output_1->Set<FastNoise::Dim::Z>(0.0f);
+                        position_output_1->Set<FastNoise::Dim::W>(0.0f);
 
-                    position_output_1->Set<FastNoise::Dim::X>(0.0f);
-                    position_output_1->Set<FastNoise::Dim::Y>(3.0f);
-                    position_output_1->Set<FastNoise::Dim::Z>(0.0f);
-                    position_output_1->Set<FastNoise::Dim::W>(0.0f);
+                        add_1->SetLHS(domain_scale_1);
+                        add_1->SetRHS(position_output_1);
 
-                    add_1->SetLHS(domain_scale_1);
-                    add_1->SetRHS(position_output_1);
+                        domain_warp_grad_1->SetSource(add_1);
+                        domain_warp_grad_1->SetWarpAmplitude(0.2f);
+                        domain_warp_grad_1->SetWarpFrequency(2.0f);
 
-                    domain_warp_grad_1->SetSource(add_1);
-                    domain_warp_grad_1->SetWarpAmplitude(0.2f);
-                    domain_warp_grad_1->SetWarpFrequency(2.0f);
+                        domain_warp_fract_prog_1->SetSource(domain_warp_grad_1);
+                        domain_warp_fract_prog_1->SetGain(0.6f);
+                        domain_warp_fract_prog_1->SetOctaveCount(2);
+                        domain_warp_fract_prog_1->SetLacunarity(2.5f);
 
-                    domain_warp_fract_prog_1->SetSource(domain_warp_grad_1);
-                    domain_warp_fract_prog_1->SetGain(0.6f);
-                    domain_warp_fract_prog_1->SetOctaveCount(2);
-                    domain_warp_fract_prog_1->SetLacunarity(2.5f);
+                        generator = domain_warp_fract_prog_1;
+                        data.resize(CHUNK_VOLUME);
+                        blocks.resize(CHUNK_VOLUME);
+                    }
 
-                    f32* data = new f32[CHUNK_VOLUME];
-                    domain_warp_fract_prog_1->GenUniformGrid3D(
-                        data,
+                    FastNoise::SmartNode<>   generator;
+                    std::vector<f32>         data;
+                    std::vector<hvox::Block> blocks;
+                };
+
+                void operator()(
+                    hmem::Handle<hvox::Chunk> chunk, ThreadState& state
+                ) const {
+                    state.generator->GenUniformGrid3D(
+                        state.data.data(),
                         static_cast<int>(chunk->position.x) * CHUNK_LENGTH,
                         -1 * static_cast<int>(chunk->position.y) * CHUNK_LENGTH,
                         static_cast<int>(chunk->position.z) * CHUNK_LENGTH,
@@ -66,22 +73,18 @@ namespace hemlock {
 
                     {
                         std::unique_lock<std::shared_mutex> lock;
-                        auto blocks = chunk->blocks.get(lock);
-
-                        ui64 noise_idx = 0;
-                        for (ui8 z = 0; z < CHUNK_LENGTH; ++z) {
-                            for (ui8 y = 0; y < CHUNK_LENGTH; ++y) {
-                                for (ui8 x = 0; x < CHUNK_LENGTH; ++x) {
-                                    blocks[hvox::block_index(
-                                        { x, CHUNK_LENGTH - y - 1, z }
-                                    )] = data[noise_idx++] > 0 ? hvox::Block{ 1 } :
-                                                                 hvox::Block{ 0 };
-                                }
-                            }
-                        }
-                    }
+                        auto& blocks = chunk->blocks.get(lock);
 
-                    delete[] data;
+                        hvox::threshold_noise(
+                            state.data.data(),
+                            0.0f,
+                            hvox::Block{ 1 },
+                            hvox::Block{ 0 },
+                            state.blocks.data(),
+                            blocks,
+                            true
+                        );
+                    }
                 }
             };
 
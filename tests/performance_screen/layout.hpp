@@ -0,0 +1,116 @@
+#ifndef __hemlock_tests_performance_screen_layout_hpp
+#define __hemlock_tests_performance_screen_layout_hpp
+
+#include "voxel/block_layout.hpp"
+
+namespace hemlock {
+    namespace test {
+        namespace performance_screen {
+            /**
+             * @brief Mimics the access patterns of navmeshing and greedy
+             * meshing over blocks held in any layout, so that layouts can be
+             * compared within one build. Blocks may be held as just their
+             * IDs, of any width, so that widths can be compared too.
+             */
+            template <hvox::BlockLayout Layout, typename Element = hvox::Block>
+            struct LayoutBenchmark {
+                static void relayout(const hvox::BlockBuffer& blocks, Element* out) {
+                    hvox::for_each_block<Layout>(
+                        [&](hvox::BlockIndex index, hvox::BlockChunkPosition position) {
+                            const hvox::Block& block
+                                = blocks[hvox::block_index(position)];
+
+                            if constexpr (std::is_same_v<Element, hvox::Block>) {
+                                out[index] = block;
+                            } else {
+                                out[index] = static_cast<Element>(block.id);
+                            }
+                        }
+                    );
+                }
+
+                static const Element&
+                at(const Element* blocks, ui32 x, ui32 y, ui32 z) {
+                    return blocks[hvox::layout_block_index<Layout>({ x, y, z })];
+                }
+
+                static bool is_air(const Element& element) {
+                    if constexpr (std::is_same_v<Element, hvox::Block>) {
+                        return element.id == 0;
+                    } else {
+                        return element == 0;
+                    }
+                }
+
+                /**
+                 * @brief Finds standable blocks and checks which of their
+                 * horizontal neighbours could be stepped to, as the bulk
+                 * navmesh pass does.
+                 */
+                static ui32 navmesh(const Element* blocks) {
+                    ui32 steps = 0;
+
+                    for (ui32 x = 1; x < CHUNK_LENGTH - 1; ++x) {
+                        for (ui32 z = 1; z < CHUNK_LENGTH - 1; ++z) {
+                            for (ui32 y = 1; y < CHUNK_LENGTH - 2; ++y) {
+                                if (is_air(at(blocks, x, y, z))) continue;
+                                if (!is_air(at(blocks, x, y + 1, z))) continue;
+
+                                for (auto [dx, dz] : { std::pair{ -1, 0 },
+                                                       std::pair{ 1, 0 },
+                                                       std::pair{ 0, -1 },
+                                                       std::pair{ 0, 1 } })
+                                {
+                                    ui32 nx = x + static_cast<ui32>(dx);
+                                    ui32 nz = z + static_cast<ui32>(dz);
+
+                                    for (ui32 ny = y - 1; ny <= y + 1; ++ny) {
+                                        if (!is_air(at(blocks, nx, ny, nz))
+                                            && is_air(at(blocks, nx, ny + 1, nz)))
+                                            ++steps;
+                                    }
+                                }
+                            }
+                        }
+                    }
+
+                    return steps;
+                }
+
+                /**
+                 * @brief Grows runs of like blocks along y and then z, as
+                 * greedy meshing does.
+                 */
+                static ui32 mesh(const Element* blocks) {
+                    ui32 runs = 0;
+
+                    for (ui32 x = 0; x < CHUNK_LENGTH; ++x) {
+                        for (ui32 z = 0; z < CHUNK_LENGTH; ++z) {
+                            for (ui32 y = 0; y < CHUNK_LENGTH;) {
+                                const Element& source = at(blocks, x, y, z);
+
+                                ui32 end_y = y + 1;
+                                while (end_y < CHUNK_LENGTH
+                                       && at(blocks, x, end_y, z) == source)
+                                    ++end_y;
+
+                                ui32 end_z = z + 1;
+                                while (end_z < CHUNK_LENGTH
+                                       && at(blocks, x, y, end_z) == source)
+                                    ++end_z;
+
+                                runs += (end_z - z);
+                                y     = end_y;
+                            }
+                        }
+                    }
+
+                    return runs;
+                }
+            };
+        }  // namespace performance_screen
+    }      // namespace test
+}  // namespace hemlock
+namespace htest = hemlock::test;
+
+#endif  // __hemlock_tests_performance_screen_layout_hpp
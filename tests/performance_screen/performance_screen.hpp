@@ -13,12 +13,14 @@
 #include "voxel/ai/navmesh/strategy/naive/strategy.hpp"
 #include "voxel/chunk/state.hpp"
 #include "voxel/generation/generator_task.hpp"
+#include "voxel/generation/noise.h"
 #include "voxel/graphics/mesh/greedy_strategy.hpp"
 #include "voxel/graphics/mesh/instance_manager.h"
 #include "voxel/graphics/mesh/naive_strategy.hpp"
 
 #include "tests/iomanager.hpp"
 
+#include "tests/performance_screen/layout.hpp"
 #include "tests/performance_screen/terrain.hpp"
 
 // Note(Matthew): Some thoughts about chunk prep timings. If we think of modern trains,
@@ -122,13 +124,23 @@ public:
             }
 
             // const htest::performance_screen::VoxelGenerator generator{};
-            const htest::performance_screen::VoxelGeneratorV2 generator{};
+            // const htest::performance_screen::VoxelGeneratorV2 generator{};
+            // Define PERFORMANCE_SCREEN_SIMD_LEVEL as a FastSIMD::eLevel to
+            // profile generation at a lower SIMD level than the CPU supports.
+#if defined(PERFORMANCE_SCREEN_SIMD_LEVEL)
+            hvox::override_noise_simd_level(PERFORMANCE_SCREEN_SIMD_LEVEL);
+#endif
+            std::cout << "Generating noise at SIMD level "
+                      << static_cast<ui32>(hvox::noise_simd_level()) << std::endl;
+
+            const htest::performance_screen::VoxelGeneratorV3 generator{};
+            htest::performance_screen::VoxelGeneratorV3::ThreadState generator_state{};
 
             // Do generation profiling.
             {
                 auto start = std::chrono::high_resolution_clock::now();
                 for (ui32 iteration = 0; iteration < iterations; ++iteration) {
-                    generator(chunks[iteration]);
+                    generator(chunks[iteration], generator_state);
                 }
                 auto duration = std::chrono::high_resolution_clock::now() - start;
                 auto duration_us
@@ -164,9 +176,10 @@ public:
                 ));
 
                 std::shared_lock<std::shared_mutex> lock;
-                auto blocks = chunks[rand_chunk_idx]->blocks.get(lock);
+                auto& blocks = chunks[rand_chunk_idx]->blocks.get(lock);
 
-                std::cout << "    - " << blocks[rand_block_idx].id << std::endl;
+                std::cout << "    - " << static_cast<ui64>(blocks[rand_block_idx].id)
+                          << std::endl;
             }
 
             const hvox::NaiveMeshStrategy<htest::performance_screen::BlockComparator>
@@ -350,6 +363,116 @@ public:
                           << std::endl;
             }
 
+            // Compare block layouts, and widths of block IDs, on navmesh and
+            // meshing access patterns. The strategies above run against
+            // whichever layout and width this build uses, while these run over
+            // copies of the blocks, so each can be compared within one build.
+            {
+                const ui32 layout_chunks = std::min(iterations, 512u);
+
+                auto profile_blocks = [&]<hvox::BlockLayout Layout, typename Element>(
+                                          std::string name, bool in_use, f32 row
+                                      ) {
+                    using Benchmark
+                        = htest::performance_screen::LayoutBenchmark<Layout, Element>;
+
+                    std::vector<Element> layout_blocks(layout_chunks * (CHUNK_VOLUME));
+
+                    for (ui32 iteration = 0; iteration < layout_chunks; ++iteration) {
+                        std::shared_lock<std::shared_mutex> lock;
+                        Benchmark::relayout(
+                            chunks[iteration]->blocks.get(lock),
+                            &layout_blocks[iteration * (CHUNK_VOLUME)]
+                        );
+                    }
+
+                    ui32 total = 0;
+
+                    auto navmesh_start = std::chrono::high_resolution_clock::now();
+                    for (ui32 iteration = 0; iteration < layout_chunks; ++iteration) {
+                        total += Benchmark::navmesh(
+                            &layout_blocks[iteration * (CHUNK_VOLUME)]
+                        );
+                    }
+                    auto navmesh_duration_us
+                        = std::chrono::duration_cast<std::chrono::microseconds>(
+                              std::chrono::high_resolution_clock::now() - navmesh_start
+                        )
+                              .count();
+
+                    auto mesh_start = std::chrono::high_resolution_clock::now();
+                    for (ui32 iteration = 0; iteration < layout_chunks; ++iteration) {
+                        total += Benchmark::mesh(
+                            &layout_blocks[iteration * (CHUNK_VOLUME)]
+                        );
+                    }
+                    auto mesh_duration_us
+                        = std::chrono::duration_cast<std::chrono::microseconds>(
+                              std::chrono::high_resolution_clock::now() - mesh_start
+                        )
+                              .count();
+
+                    // Force compiler to not optimise away intermediate results.
+                    std::cout << "    - " << total << std::endl;
+
+                    auto navmesh_avg_duration_us = static_cast<f32>(navmesh_duration_us)
+                                                   / static_cast<f32>(layout_chunks);
+                    auto mesh_avg_duration_us = static_cast<f32>(mesh_duration_us)
+                                                / static_cast<f32>(layout_chunks);
+
+                    // Bytes touched by a full scan over the blocks of one chunk.
+                    size_t scan_KB = sizeof(Element) * (CHUNK_VOLUME) / 1000;
+
+                    if (in_use) name += " (in use)";
+
+                    std::string msg = name + ": navmesh "
+                                      + std::to_string(navmesh_avg_duration_us)
+                                      + "us // meshing "
+                                      + std::to_string(mesh_avg_duration_us)
+                                      + "us // scan " + std::to_string(scan_KB)
+                                      + "KB";
+                    m_sprite_batcher.add_string(
+                        msg.c_str(),
+                        f32v4{ 40.0f, row, 1000.0f, 100.0f },
+                        f32v4{ 35.0f, row - 5.0f, 1010.0f, 110.0f },
+                        hg::f::StringSizing{ hg::f::StringSizingKind::SCALED,
+                                             { f32v2{ 0.85f } } },
+                        colour4{ 0, 0, 0, 255 },
+                        "fonts/Orbitron-Regular.ttf",
+                        hg::f::TextAlign::TOP_LEFT,
+                        hg::f::WordWrap::NONE
+                    );
+                    m_sprite_batcher.end();
+                };
+
+                using hvox::BlockLayout;
+
+                profile_blocks.template operator()<BlockLayout::LINEAR, hvox::Block>(
+                    "Linear layout", hvox::BLOCK_LAYOUT == BlockLayout::LINEAR, 420.0f
+                );
+                profile_blocks.template operator()<BlockLayout::MORTON, hvox::Block>(
+                    "Morton layout", hvox::BLOCK_LAYOUT == BlockLayout::MORTON, 480.0f
+                );
+                profile_blocks.template operator()<BlockLayout::TILED, hvox::Block>(
+                    "Tiled layout", hvox::BLOCK_LAYOUT == BlockLayout::TILED, 540.0f
+                );
+
+                // IDs are narrowed as copied, which is harmless as the terrain
+                // generated here uses only the first few.
+                profile_blocks.template operator()<hvox::BLOCK_LAYOUT, ui8>(
+                    "8-bit block IDs", HEMLOCK_BLOCK_ID_BITS == 8, 600.0f
+                );
+                profile_blocks.template operator()<hvox::BLOCK_LAYOUT, ui16>(
+                    "16-bit block IDs", HEMLOCK_BLOCK_ID_BITS == 16, 660.0f
+                );
+                profile_blocks.template operator()<hvox::BLOCK_LAYOUT, ui32>(
+                    "32-bit block IDs", HEMLOCK_BLOCK_ID_BITS == 32, 720.0f
+                );
+                profile_blocks.template operator()<hvox::BLOCK_LAYOUT, ui64>(
+                    "64-bit block IDs", HEMLOCK_BLOCK_ID_BITS == 64, 780.0f
+                );
+            }
+
             {
                 size_t allocated_bytes = block_pager->allocated_bytes()
                                          + instance_pager->allocated_bytes()
@@ -372,6 +495,36 @@ public:
                 m_sprite_batcher.end();
             }
 
+            {
+                size_t block_bytes = 0;
+                for (ui32 iteration = 0; iteration < iterations; ++iteration) {
+                    block_bytes += chunks[iteration]->blocks.allocated_bytes();
+                }
+                size_t block_KB = block_bytes / 1000;
+
+                // Bytes touched by a full scan over the blocks of one chunk, which
+                // is what bounds meshing, navmeshing and the like.
+                size_t scan_KB = sizeof(hvox::Block) * (CHUNK_VOLUME) / 1000;
+
+                std::string msg = "Block memory: " + std::to_string(block_KB)
+                                  + "KB // per-chunk scan "
+                                  + std::to_string(scan_KB) + "KB ("
+                                  + std::to_string(HEMLOCK_BLOCK_ID_BITS)
+                                  + "-bit block IDs)";
+                m_sprite_batcher.add_string(
+                    msg.c_str(),
+                    f32v4{ 40.0f, 360.0f, 1000.0f, 100.0f },
+                    f32v4{ 35.0f, 355.0f, 1010.0f, 110.0f },
+                    hg::f::StringSizing{ hg::f::StringSizingKind::SCALED,
+                                         { f32v2{ 0.85f } } },
+                    colour4{ 0, 0, 0, 255 },
+                    "fonts/Orbitron-Regular.ttf",
+                    hg::f::TextAlign::TOP_LEFT,
+                    hg::f::WordWrap::NONE
+                );
+                m_sprite_batcher.end();
+            }
+
             std::cout << "Generation profiling complete." << std::endl;
 
             delete[] chunks;
@@ -4,58 +4,129 @@
 namespace hemlock {
     namespace test {
         namespace voxel_screen {
-            struct TVS_VoxelGenerator {
-                void operator()(hmem::Handle<hvox::Chunk> chunk) const {
-                    auto simplex_1
-                        = FastNoise::New<FastNoise::Simplex>(FastSIMD::Level_AVX512);
-                    auto fractal_1
-                        = FastNoise::New<FastNoise::FractalFBm>(FastSIMD::Level_AVX512);
-                    auto domain_scale_1
-                        = FastNoise::New<FastNoise::DomainScale>(FastSIMD::Level_AVX512
-                        );
-                    auto position_output_1 = FastNoise::New<FastNoise::PositionOutput>(
-                        FastSIMD::Level_AVX512
+            // The height, in blocks, below which each column of blocks is
+            // solid, such that the world has a floor beneath its caves. It is
+            // the same for every chunk of a column, and so is computed once
+            // for the column through its generation data.
+            struct TVS_Floor {
+                static constexpr f32 BASE      = 8.0f;
+                static constexpr f32 AMPLITUDE = 8.0f;
+
+                i32 heights[CHUNK_AREA];
+            };
+
+            const TVS_Floor& floor_of(
+                hmem::Handle<hvox::Chunk> chunk, FastNoise::SmartNode<>& generator
+            ) {
+                return chunk->column_data->product<TVS_Floor>([&](TVS_Floor& floor) {
+                    f32 noise[CHUNK_AREA];
+                    generator->GenUniformGrid2D(
+                        noise,
+                        static_cast<int>(chunk->position.x) * CHUNK_LENGTH,
+                        static_cast<int>(chunk->position.z) * CHUNK_LENGTH,
+                        CHUNK_LENGTH,
+                        CHUNK_LENGTH,
+                        0.01f,
+                        1337
                     );
-                    auto add_1 = FastNoise::New<FastNoise::Add>(FastSIMD::Level_AVX512);
-                    auto domain_warp_grad_1
-                        = FastNoise::New<FastNoise::DomainWarpGradient>(
-                            FastSIMD::Level_AVX512
+
+                    // Noise is laid out x-fastest, just as heights are.
+                    for (ui32 i = 0; i < CHUNK_AREA; ++i) {
+                        floor.heights[i] = static_cast<i32>(
+                            TVS_Floor::BASE + TVS_Floor::AMPLITUDE * noise[i]
                         );
-                    auto domain_warp_fract_prog_1
-                        = FastNoise::New<FastNoise::DomainWarpFractalProgressive>(
-                            FastSIMD::Level_AVX512
+                    }
+                });
+            }
+
+            void fill_floor(
+                hvox::ChunkGridPosition position,
+                const TVS_Floor&        floor,
+                hvox::BlockBuffer&      blocks
+            ) {
+                const i32 bottom = static_cast<i32>(position.y) * CHUNK_LENGTH;
+
+                for (hvox::BlockChunkPositionCoord z = 0; z < CHUNK_LENGTH; ++z) {
+                    for (hvox::BlockChunkPositionCoord x = 0; x < CHUNK_LENGTH; ++x) {
+                        const i32 height = floor.heights[x + z * CHUNK_LENGTH] - bottom;
+                        if (height <= 0) continue;
+
+                        const auto top = static_cast<hvox::BlockChunkPositionCoord>(
+                            glm::min(height, static_cast<i32>(CHUNK_LENGTH)) - 1
                         );
+                        blocks.fill({ x, 0, z }, { x, top, z }, hvox::Block{ 1 });
+                    }
+                }
+            }
+
+            struct TVS_VoxelGenerator {
+                // Built once per thread, rather than once per chunk.
+                struct ThreadState {
+                    ThreadState() {
+                        auto simplex_1 = hvox::new_noise_node<FastNoise::Simplex>();
+                        auto fractal_1
+                            = hvox::new_noise_node<FastNoise::FractalFBm>();
+                        auto domain_scale_1
+                            = hvox::new_noise_node<FastNoise::DomainScale>();
+                        auto position_output_1
+                            = hvox::new_noise_node<FastNoise::PositionOutput>();
+                        auto add_1 = hvox::new_noise_node<FastNoise::Add>();
+                        auto domain_warp_grad_1
+                            = hvox::new_noise_node<FastNoise::DomainWarpGradient>();
+                        auto domain_warp_fract_prog_1 = hvox::new_noise_node<
+                            FastNoise::DomainWarpFractalProgressive>();
+
+                        fractal_1->SetSource(simplex_1);
+                        fractal_1->SetOctaveCount(4);
+                        fractal_1->SetGain(0.5f);
+                        fractal_1->SetLacunarity(2.5f);
 
-                    fractal_1->SetSource(simplex_1);
-                    fractal_1->SetOctaveCount(4);
-                    fractal_1->SetGain(0.5f);
-                    fractal_1->SetLacunarity(2.5f);
+                        domain_scale_1->SetSource(fractal_1);
+                        domain_scale_1->SetScale(0.66f);
 
-                    domain_scale_1->SetSource(fractal_1);
-                    domain_scale_1->SetScale(0.66f);
+                        position_output_1->Set<FastNoise::Dim::X>(0.0f);
+                        position_output_1->Set<FastNoise::Dim::Y>(3.0f);
+                        position_output_1->Set<FastNoise::Dim::Z>(0.0f);
+                        position_output_1->Set<FastNoise::Dim::W>(0.0f);
 
-                    position_output_1->Set<FastNoise::Dim::X>(0.0f);
-                    position_output_1->Set<FastNoise::Dim::Y>(3.0f);
-                    position_output_1->Set<FastNoise::Dim::Z>(0.0f);
-                    position_output_1->Set<FastNoise::Dim::W>(0.0f);
+                        add_1->SetLHS(domain_scale_1);
+                        add_1->SetRHS(position_output_1);
 
-                    add_1->SetLHS(domain_scale_1);
-                    add_1->SetRHS(position_output_1);
+                        domain_warp_grad_1->SetSource(add_1);
+                        domain_warp_grad_1->SetWarpAmplitude(0.2f);
+                        domain_warp_grad_1->SetWarpFrequency(2.0f);
 
-                    domain_warp_grad_1->SetSource(add_1);
-                    domain_warp_grad_1->SetWarpAmplitude(0.2f);
-                    domain_warp_grad_1->SetWarpFrequency(2.0f);
+                        domain_warp_fract_prog_1->SetSource(domain_warp_grad_1);
+                        domain_warp_fract_prog_1->SetGain(0.6f);
+                        domain_warp_fract_prog_1->SetOctaveCount(2);
+                        domain_warp_fract_prog_1->SetLacunarity(2.5f);
 
-                    domain_warp_fract_prog_1->SetSource(domain_warp_grad_1);
-                    domain_warp_fract_prog_1->SetGain(0.6f);
-                    domain_warp_fract_prog_1->SetOctaveCount(2);
-                    domain_warp_fract_prog_1->SetLacunarity(2.5f);
+                        generator = domain_warp_fract_prog_1;
 
-                    f32* data = new f32[CHUNK_VOLUME];
-                    domain_warp_fract_prog_1->GenUniformGrid3D(
+                        auto simplex_2 = hvox::new_noise_node<FastNoise::Simplex>();
+                        auto fractal_2 = hvox::new_noise_node<FastNoise::FractalFBm>();
+
+                        fractal_2->SetSource(simplex_2);
+                        fractal_2->SetOctaveCount(3);
+
+                        floor_generator = fractal_2;
+
+                        data.resize(CHUNK_VOLUME);
+                        blocks.resize(CHUNK_VOLUME);
+                    }
+
+                    FastNoise::SmartNode<>   generator, floor_generator;
+                    std::vector<f32>         data;
+                    std::vector<hvox::Block> blocks;
+                };
+
+                void operator()(
+                    hmem::Handle<hvox::Chunk> chunk, ThreadState& state
+                ) const {
+                    state.generator->GenUniformGrid3D(
                         // domain_warp_grad_1->GenUniformGrid3D(
                         // fractal_1.get()->GenUniformGrid3D(
-                        data,
+                        state.data.data(),
                         static_cast<int>(chunk->position.x) * CHUNK_LENGTH,
                         -1 * static_cast<int>(chunk->position.y) * CHUNK_LENGTH,
                         static_cast<int>(chunk->position.z) * CHUNK_LENGTH,
@@ -65,6 +136,9 @@ namespace hemlock {
                         0.005f,
                         1337
                     );
+
+                    const TVS_Floor& floor = floor_of(chunk, state.floor_generator);
+
                     // f32* data = new f32[CHUNK_AREA];
                     // domain_warp_fract_prog_1->GenUniformGrid2D(
                     // // domain_warp_grad_1->GenUniformGrid2D(
@@ -80,19 +154,19 @@ namespace hemlock {
 
                     {
                         std::unique_lock<std::shared_mutex> lock;
-                        auto blocks = chunk->blocks.get(lock);
-
-                        ui64 noise_idx = 0;
-                        for (ui8 z = 0; z < CHUNK_LENGTH; ++z) {
-                            for (ui8 y = 0; y < CHUNK_LENGTH; ++y) {
-                                for (ui8 x = 0; x < CHUNK_LENGTH; ++x) {
-                                    blocks[hvox::block_index(
-                                        { x, CHUNK_LENGTH - y - 1, z }
-                                    )] = data[noise_idx++] > 0 ? hvox::Block{ 1 } :
-                                                                 hvox::Block{ 0 };
-                                }
-                            }
-                        }
+                        auto& blocks = chunk->blocks.get(lock);
+
+                        hvox::threshold_noise(
+                            state.data.data(),
+                            0.0f,
+                            hvox::Block{ 1 },
+                            hvox::Block{ 0 },
+                            state.blocks.data(),
+                            blocks,
+                            true
+                        );
+
+                        fill_floor(chunk->position, floor, blocks);
                     }
 
                     // hvox::set_blocks(chunk, hvox::BlockChunkPosition{0},
@@ -111,31 +185,79 @@ namespace hemlock {
                     //         - y, CHUNK_LENGTH - 1), z}, hvox::Block{1});
                     //     }
                     // }
-
-                    delete[] data;
                 }
             };
 
-            void load_chunks(hmem::Handle<hvox::ChunkGrid> chunk_grid) {
-                for (auto x = -VIEW_DIST; x <= VIEW_DIST; ++x) {
-                    for (auto z = -VIEW_DIST; z <= VIEW_DIST; ++z) {
-                        for (auto y = -2; y < 6; ++y) {
-                            chunk_grid->preload_chunk_at({
-                                {x, y, z}
-                            });
-                        }
-                    }
-                }
-                for (auto x = -VIEW_DIST; x <= VIEW_DIST; ++x) {
-                    for (auto z = -VIEW_DIST; z <= VIEW_DIST; ++z) {
-                        for (auto y = -2; y < 6; ++y) {
-                            chunk_grid->load_chunk_at({
-                                {x, y, z}
-                            });
+            struct TVS_ColumnVoxelGenerator {
+                struct ThreadState : public TVS_VoxelGenerator::ThreadState {
+                    std::vector<f32> column_data;
+                };
+
+                void operator()(
+                    hvox::ChunkGridPosition          bottom,
+                    const hmem::Handle<hvox::Chunk>* chunks,
+                    ui32                             chunk_count,
+                    ThreadState&                     state
+                ) const {
+                    // Noise for the whole run is generated in one go, from the
+                    // top of the run down just as it is for each chunk alone.
+                    const ui32 column_height = chunk_count * CHUNK_LENGTH;
+                    const i32  top           = static_cast<i32>(bottom.y)
+                                      + static_cast<i32>(chunk_count) - 1;
+
+                    state.column_data.resize(CHUNK_AREA * column_height);
+
+                    state.generator->GenUniformGrid3D(
+                        state.column_data.data(),
+                        static_cast<int>(bottom.x) * CHUNK_LENGTH,
+                        -1 * top * CHUNK_LENGTH,
+                        static_cast<int>(bottom.z) * CHUNK_LENGTH,
+                        CHUNK_LENGTH,
+                        column_height,
+                        CHUNK_LENGTH,
+                        0.005f,
+                        1337
+                    );
+
+                    // Every chunk of the run shares the one floor of its
+                    // column.
+                    const TVS_Floor* floor = nullptr;
+
+                    for (ui32 i = 0; i < chunk_count; ++i) {
+                        if (chunks[i] == nullptr) continue;
+
+                        if (floor == nullptr)
+                            floor = &floor_of(chunks[i], state.floor_generator);
+
+                        // Each z of the chunk is one contiguous slab of the
+                        // run's noise, the top chunk's slab coming first.
+                        const ui32 first_row = (chunk_count - i - 1) * CHUNK_LENGTH;
+                        for (ui32 z = 0; z < CHUNK_LENGTH; ++z) {
+                            std::copy_n(
+                                &state.column_data
+                                     [CHUNK_LENGTH * (first_row + column_height * z)],
+                                CHUNK_AREA,
+                                &state.data[CHUNK_AREA * z]
+                            );
                         }
+
+                        std::unique_lock<std::shared_mutex> lock;
+                        auto& blocks = chunks[i]->blocks.get(lock);
+
+                        hvox::threshold_noise(
+                            state.data.data(),
+                            0.0f,
+                            hvox::Block{ 1 },
+                            hvox::Block{ 0 },
+                            state.blocks.data(),
+                            blocks,
+                            true
+                        );
+
+                        fill_floor(chunks[i]->position, *floor, blocks);
                     }
                 }
-            }
+            };
 
             void
             unload_chunks(hmem::Handle<hvox::ChunkGrid> chunk_grid, f32 frame_time) {
@@ -160,124 +282,6 @@ namespace hemlock {
                     }
                 }
             }
-
-            void unload_x_chunks(
-                hmem::Handle<hvox::ChunkGrid>               chunk_grid,
-                std::vector<hmem::WeakHandle<hvox::Chunk>>& unloading_chunks,
-                const f32v3&                                current_pos,
-                const f32v3&                                last_pos
-            ) {
-                i32 x_step
-                    = static_cast<i32>(current_pos.x) - static_cast<i32>(last_pos.x);
-                if (x_step != 0) {
-                    for (auto z = static_cast<i32>(current_pos.z) - VIEW_DIST;
-                         z <= static_cast<i32>(current_pos.z) + VIEW_DIST;
-                         ++z)
-                    {
-                        for (auto y = -2; y < 6; ++y) {
-                            unloading_chunks.emplace_back(
-                                hmem::WeakHandle<hvox::Chunk>{}
-                            );
-                            auto& handle = unloading_chunks.back();
-                            chunk_grid->unload_chunk_at(
-                                {
-                                    {x_step < 0 ? static_cast<i32>(current_pos.x)
-+ VIEW_DIST + 1 :
-static_cast<i32>(current_pos.x)
-- VIEW_DIST - 1,
-                                     y, z}
-                            },
-                                &handle
-                            );
-                        }
-                    }
-                    for (auto z = static_cast<i32>(current_pos.z) - VIEW_DIST;
-                         z <= static_cast<i32>(current_pos.z) + VIEW_DIST;
-                         ++z)
-                    {
-                        for (auto y = -2; y < 6; ++y) {
-                            chunk_grid->preload_chunk_at({
-                                {x_step < 0 ?
-static_cast<i32>(current_pos.x) - VIEW_DIST :
-static_cast<i32>(current_pos.x) + VIEW_DIST,
-                                 y, z}
-                            });
-                        }
-                    }
-                    for (auto z = static_cast<i32>(current_pos.z) - VIEW_DIST;
-                         z <= static_cast<i32>(current_pos.z) + VIEW_DIST;
-                         ++z)
-                    {
-                        for (auto y = -2; y < 6; ++y) {
-                            chunk_grid->load_chunk_at({
-                                {x_step < 0 ?
-static_cast<i32>(current_pos.x) - VIEW_DIST :
-static_cast<i32>(current_pos.x) + VIEW_DIST,
-                                 y, z}
-                            });
-                        }
-                    }
-                }
-            }
-
-            void unload_z_chunks(
-                hmem::Handle<hvox::ChunkGrid>               chunk_grid,
-                std::vector<hmem::WeakHandle<hvox::Chunk>>& unloading_chunks,
-                const f32v3&                                current_pos,
-                const f32v3&                                last_pos
-            ) {
-                i32 z_step
-                    = static_cast<i32>(current_pos.z) - static_cast<i32>(last_pos.z);
-                if (z_step != 0) {
-                    for (auto x = static_cast<i32>(current_pos.x) - VIEW_DIST;
-                         x <= static_cast<i32>(current_pos.x) + VIEW_DIST;
-                         ++x)
-                    {
-                        for (auto y = -2; y < 6; ++y) {
-                            unloading_chunks.emplace_back(
-                                hmem::WeakHandle<hvox::Chunk>{}
-                            );
-                            auto& handle = unloading_chunks.back();
-                            chunk_grid->unload_chunk_at(
-                                {
-                                    {x,
-                                     y, z_step < 0 ? static_cast<i32>(current_pos.z)
- + VIEW_DIST + 1 :
- static_cast<i32>(current_pos.z)
- - VIEW_DIST - 1}
-                            },
-                                &handle
-                            );
-                        }
-                    }
-                    for (auto x = static_cast<i32>(current_pos.x) - VIEW_DIST;
-                         x <= static_cast<i32>(current_pos.x) + VIEW_DIST;
-                         ++x)
-                    {
-                        for (auto y = -2; y < 6; ++y) {
-                            chunk_grid->preload_chunk_at({
-                                {x,
-                                 y, z_step < 0 ?
- static_cast<i32>(current_pos.z) - VIEW_DIST :
- static_cast<i32>(current_pos.z) + VIEW_DIST}
-                            });
-                        }
-                    }
-                    for (auto x = static_cast<i32>(current_pos.x) - VIEW_DIST;
-                         x <= static_cast<i32>(current_pos.x) + VIEW_DIST;
-                         ++x)
-                    {
-                        for (auto y = -2; y < 6; ++y) {
-                            chunk_grid->load_chunk_at({
-                                {x,
-                                 y, z_step < 0 ?
- static_cast<i32>(current_pos.z) - VIEW_DIST :
- static_cast<i32>(current_pos.z) + VIEW_DIST}
-                            });
-                        }
-                    }
-                }
-            }
         }  // namespace voxel_screen
     }      // namespace test
 }  // namespace hemlock
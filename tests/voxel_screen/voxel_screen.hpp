@@ -6,7 +6,10 @@
 #include <bullet/btBulletDynamicsCommon.h>
 
 #include "memory/handle.hpp"
+#include "voxel/chunk/streamer.h"
+#include "voxel/generation/column_task.hpp"
 #include "voxel/generation/generator_task.hpp"
+#include "voxel/generation/noise.h"
 #include "voxel/graphics/mesh/greedy_strategy.hpp"
 #include "voxel/graphics/mesh/mesh_task.hpp"
 #include "voxel/graphics/outline_renderer.hpp"
@@ -22,6 +25,10 @@
 #  define VIEW_DIST 10
 #endif
 
+// The bytes chunks may hold before those furthest from the player are
+// dehydrated.
+#define RESIDENCY_BUDGET (256ull * 1024 * 1024)
+
 #include "tests/voxel_screen/io.hpp"
 #include "tests/voxel_screen/physics.hpp"
 #include "tests/voxel_screen/player.hpp"
@@ -50,20 +57,17 @@ public:
 
         m_outline_renderer.dispose();
 
-        m_chunk_grid->dispose();
+        m_chunk_streamer.dispose();
 
-        happ::ScreenBase::dispose();
-    }
+        m_chunk_grid->set_residency_manager(nullptr);
+        m_residency_manager.dispose();
 
-    virtual void start(hemlock::FrameTime time) override {
-        happ::ScreenBase::start(time);
+        m_chunk_grid->dispose();
 
-        htest::voxel_screen::load_chunks(m_chunk_grid);
+        happ::ScreenBase::dispose();
     }
 
     virtual void update(hemlock::FrameTime time) override {
-        static f32v3 last_pos{ 0.0f };
-
         static bool do_chunk_check = false;
         static bool do_unloads     = false;
 
@@ -129,15 +133,17 @@ public:
         f32v3 current_pos
             = glm::floor(m_camera.position() / static_cast<f32>(CHUNK_LENGTH));
 
-        htest::voxel_screen::unload_x_chunks(
-            m_chunk_grid, m_unloading_chunks, current_pos, last_pos
-        );
-
-        htest::voxel_screen::unload_z_chunks(
-            m_chunk_grid, m_unloading_chunks, current_pos, last_pos
-        );
+        // Chunks are loaded about the player as they move, and unloaded
+        // once left behind.
+        hvox::ChunkGridPosition focus_point = {
+            {static_cast<i64>(current_pos.x),
+             static_cast<i64>(current_pos.y),
+             static_cast<i64>(current_pos.z)}
+        };
+        m_chunk_streamer.set_focus_points(&focus_point, 1);
+        m_residency_manager.set_focus_points(&focus_point, 1);
 
-        last_pos = current_pos;
+        m_chunk_streamer.update();
 
         m_chunk_grid->update(time);
 
@@ -238,27 +244,6 @@ public:
             } else {
                 debug_printf("No voxels in voxel patch.\n");
             }
-
-            debug_printf("Chunks still not unloaded:\n");
-            for (auto& handle : m_unloading_chunks) {
-                if (handle.expired()) continue;
-
-                auto chunk = handle.lock();
-
-                if ((chunk->position.x < static_cast<i32>(current_pos.x) - VIEW_DIST)
-                    || (chunk->position.x > static_cast<i32>(current_pos.x) - VIEW_DIST)
-                    || (chunk->position.z < static_cast<i32>(current_pos.z) - VIEW_DIST)
-                    || (chunk->position.z > static_cast<i32>(current_pos.z) - VIEW_DIST
-                    ))
-                {
-                    debug_printf(
-                        "    (%d, %d, %d)\n",
-                        static_cast<i32>(chunk->position.x),
-                        static_cast<i32>(chunk->position.y),
-                        static_cast<i32>(chunk->position.z)
-                    );
-                }
-            }
         }
     }
 
@@ -420,6 +405,21 @@ public:
             } }
         );
 
+        // Chunks stacked one on another are generated together, see
+        // TVS_ColumnVoxelGenerator.
+        hvox::ChunkColumnTaskBuilder build_column_generation_task{ []() {
+            return new hvox::ChunkColumnGenerationTask<
+                htest::voxel_screen::TVS_ColumnVoxelGenerator>();
+        } };
+        m_chunk_grid->set_column_generation_task_builder(&build_column_generation_task);
+
+        // Chunks far from the player give up their navmeshes, instance data
+        // and then raw blocks once the grid holds more than the budget.
+        m_residency_manager.init(m_chunk_grid, RESIDENCY_BUDGET);
+        m_chunk_grid->set_residency_manager(&m_residency_manager);
+
+        m_chunk_streamer.init(m_chunk_grid);
+
         m_outline_renderer.init(TVS_ChunkOutlinePredicate{}, m_chunk_grid);
 
         htest::voxel_screen::setup_physics(m_phys, m_camera, &m_line_shader);
@@ -519,6 +519,8 @@ protected:
     hcam::BasicFirstPersonCamera     m_camera;
     hui::InputManager*               m_input_manager;
     hmem::Handle<hvox::ChunkGrid>    m_chunk_grid;
+    hvox::ChunkStreamer              m_chunk_streamer;
+    hvox::ChunkResidencyManager      m_residency_manager;
     hg::GLSLProgram                  m_shader, m_line_shader, m_chunk_outline_shader;
     hthread::ThreadWorkflowDAG       m_chunk_load_dag;
     htest::voxel_screen::PlayerData  m_player;
@@ -528,10 +530,9 @@ protected:
     bool m_draw_chunk_outlines;
 
     GLuint m_crosshair_vao, m_crosshair_vbo;
-
-    std::vector<hmem::WeakHandle<hvox::Chunk>> m_unloading_chunks;
 };
 
 #undef VIEW_DIST
+#undef RESIDENCY_BUDGET
 
 #endif  // __hemlock_tests_test_voxel_screen_hpp